@@ -26,6 +26,7 @@ INCLUDEPATH += $$PWD/src/include \
 SOURCES += \
     $$PWD/src/engines/alerts/alertsmessage.cpp \
     $$PWD/src/engines/router/routerplanner.cpp \
+    $$PWD/src/engines/router/routerplannerpool.cpp \
     $$PWD/src/engines/router/routerroute.cpp \
     $$PWD/src/engines/router/routertransfer.cpp \
     $$PWD/src/engines/router/routerrouteleg.cpp \
@@ -34,6 +35,9 @@ SOURCES += \
     $$PWD/src/engines/router/routertrainprofile.cpp \
     $$PWD/src/engines/router/routerjourney.cpp \
     $$PWD/src/engines/router/routernulljourney.cpp \
+    $$PWD/src/engines/router/routerquery.cpp \
+    $$PWD/src/engines/router/routerjourneycache.cpp \
+    $$PWD/src/engines/router/routerdestinationcache.cpp \
     $$PWD/src/engines/station/stationstation.cpp \
     $$PWD/src/engines/station/stationnullstation.cpp \
     $$PWD/src/engines/station/stationfactory.cpp \
@@ -51,11 +55,16 @@ SOURCES += \
     $$PWD/src/qrail.cpp \
     $$PWD/src/network/networkeventsource.cpp \
     $$PWD/src/fragments/fragmentscache.cpp \
-    $$PWD/src/engines/router/routersnapshotjourney.cpp
+    $$PWD/src/engines/router/routersnapshotjourney.cpp \
+    $$PWD/src/fragments/fragmentsuriindex.cpp \
+    $$PWD/src/fragments/fragmentsconnectiontable.cpp \
+    $$PWD/src/fragments/fragmentspagestore.cpp \
+    $$PWD/src/fragments/fragmentspagewriter.cpp
 
 HEADERS += \
     $$PWD/src/include/engines/alerts/alertsmessage.h \
     $$PWD/src/include/engines/router/routerplanner.h \
+    $$PWD/src/include/engines/router/routerplannerpool.h \
     $$PWD/src/include/engines/router/routerroute.h \
     $$PWD/src/include/engines/router/routertransfer.h \
     $$PWD/src/include/engines/router/routerrouteleg.h \
@@ -63,6 +72,9 @@ HEADERS += \
     $$PWD/src/include/engines/router/routerstationstopprofile.h \
     $$PWD/src/include/engines/router/routertrainprofile.h \
     $$PWD/src/include/engines/router/routerjourney.h \
+    $$PWD/src/include/engines/router/routerquery.h \
+    $$PWD/src/include/engines/router/routerjourneycache.h \
+    $$PWD/src/include/engines/router/routerdestinationcache.h \
     $$PWD/src/include/engines/station/stationstation.h \
     $$PWD/src/include/engines/station/stationnullstation.h \
     $$PWD/src/include/engines/station/stationfactory.h \
@@ -82,7 +94,11 @@ HEADERS += \
     $$PWD/src/include/qrail.h \
     $$PWD/src/include/engines/router/routernulljourney.h \
     $$PWD/src/include/network/networkeventsource.h \
-    $$PWD/src/include/engines/router/routersnapshotjourney.h
+    $$PWD/src/include/engines/router/routersnapshotjourney.h \
+    $$PWD/src/include/fragments/fragmentsuriindex.h \
+    $$PWD/src/include/fragments/fragmentsconnectiontable.h \
+    $$PWD/src/include/fragments/fragmentspagestore.h \
+    $$PWD/src/include/fragments/fragmentspagewriter.h
 
 DISTFILES += \
     $$PWD/rpm/qrail.changes
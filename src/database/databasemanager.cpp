@@ -20,12 +20,12 @@
 using namespace QRail;
 QRail::Database::Manager *QRail::Database::Manager::m_instance = nullptr;
 QThreadStorage<QSqlDatabase> QRail::Database::Manager::m_database;
-QThreadStorage<QString> QRail::Database::Manager::m_path;
 
 QRail::Database::Manager::Manager(const QString &path, QObject *parent): QObject(parent)
 {
     if (QSqlDatabase::isDriverAvailable(DRIVER)) {
-        m_path.setLocalData(path);
+        // Every thread opens its own connection to the same database file
+        m_path = path;
     } else {
         qCritical() << "Missing support for SQL driver:" << DRIVER;
     }
@@ -69,7 +69,7 @@ QSqlDatabase QRail::Database::Manager::database() const
     if(!m_database.hasLocalData()) {
         qDebug() << "No local DB connection for this thread, creating one";
         QSqlDatabase db = QSqlDatabase::addDatabase(DRIVER, QUuid::createUuid().toString());
-        db.setDatabaseName(m_path.localData());
+        db.setDatabaseName(m_path);
         db.open();
         m_database.setLocalData(db);
     }
@@ -0,0 +1,89 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "engines/router/routerdestinationcache.h"
+using namespace QRail;
+
+QRail::RouterEngine::DestinationCache::DestinationCache(QObject *parent) : QObject(parent)
+{
+    m_profiles = QHash<QUrl, QRail::RouterEngine::DestinationCache::Profile>();
+    m_order = QList<QUrl>();
+    m_maxSize = DESTINATION_CACHE_SIZE;
+}
+
+bool QRail::RouterEngine::DestinationCache::profile(const QUrl &destination, const quint64 updateVersion, QRail::RouterEngine::DestinationCache::Profile *profile)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_profiles.contains(destination)) {
+        return false;
+    }
+
+    if (m_profiles.value(destination).updateVersion != updateVersion) {
+        qDebug() << "Destination profile outdated by real time updates";
+        m_profiles.remove(destination);
+        m_order.removeAll(destination);
+        return false;
+    }
+
+    if (profile) {
+        *profile = m_profiles.value(destination);
+    }
+    return true;
+}
+
+void QRail::RouterEngine::DestinationCache::insert(const QUrl &destination, const QRail::RouterEngine::DestinationCache::Profile &profile)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_maxSize <= 0) {
+        return;
+    }
+
+    // Latest profile wins, evict the least recently stored destination when the cache is full
+    m_order.removeAll(destination);
+    while (m_order.size() >= m_maxSize) {
+        m_profiles.remove(m_order.takeFirst());
+    }
+    m_profiles.insert(destination, profile);
+    m_order.append(destination);
+}
+
+void QRail::RouterEngine::DestinationCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_profiles.clear();
+    m_order.clear();
+}
+
+qint32 QRail::RouterEngine::DestinationCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_profiles.size();
+}
+
+qint32 QRail::RouterEngine::DestinationCache::maxSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxSize;
+}
+
+void QRail::RouterEngine::DestinationCache::setMaxSize(const qint32 maxSize)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxSize = maxSize;
+    while (m_order.size() > qMax(maxSize, 0)) {
+        m_profiles.remove(m_order.takeFirst());
+    }
+}
@@ -24,6 +24,8 @@ QRail::RouterEngine::Journey::Journey(QObject *parent) : QObject(parent)
     m_arrivalTime = QDateTime();
     m_hydraNext = QUrl();
     m_hydraPrevious = QUrl();
+    m_maxTransfers = 0;
+    m_partial = false;
 }
 
 RouterEngine::Journey::Journey(const QList<QSharedPointer<RouterEngine::Route >> routes,
@@ -38,6 +40,8 @@ RouterEngine::Journey::Journey(const QList<QSharedPointer<RouterEngine::Route >>
     m_arrivalTime = arrivalTime;
     m_hydraNext = hydraNext;
     m_hydraPrevious = hydraPrevious;
+    m_maxTransfers = 0;
+    m_partial = false;
 }
 
 QList<QSharedPointer<QRail::RouterEngine::Route >> QRail::RouterEngine::Journey::routes() const
@@ -47,6 +51,9 @@ QList<QSharedPointer<QRail::RouterEngine::Route >> QRail::RouterEngine::Journey:
 
 void QRail::RouterEngine::Journey::setRoutes(const QList<QSharedPointer<QRail::RouterEngine::Route >> &routes)
 {
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordRoutes(m_routes);
+    }
     m_routes = routes;
 }
 
@@ -117,12 +124,12 @@ void QRail::RouterEngine::Journey::setHydraPrevious(const QUrl &hydraPrevious)
     }
 }
 
-QMap<QUrl, QDateTime> QRail::RouterEngine::Journey::S_EarliestArrivalTime() const
+QVector<qint64> QRail::RouterEngine::Journey::S_EarliestArrivalTime() const
 {
     return m_S_EarliestArrivalTime;
 }
 
-void QRail::RouterEngine::Journey::setS_EarliestArrivalTime(const QMap<QUrl, QDateTime> &S_EarliestArrivalTime)
+void QRail::RouterEngine::Journey::setS_EarliestArrivalTime(const QVector<qint64> &S_EarliestArrivalTime)
 {
     m_S_EarliestArrivalTime = S_EarliestArrivalTime;
 }
@@ -145,6 +152,192 @@ qint16 QRail::RouterEngine::Journey::maxTransfers() const
 void QRail::RouterEngine::Journey::setMaxTransfers(const qint16 &maxTransfers)
 {
     m_maxTransfers = maxTransfers;
+    this->rebuildSTransferIndex();
+}
+
+QDateTime RouterEngine::Journey::latestDepartureTime() const
+{
+    return m_latestDepartureTime;
+}
+
+void RouterEngine::Journey::setLatestDepartureTime(const QDateTime &latestDepartureTime)
+{
+    m_latestDepartureTime = latestDepartureTime;
+}
+
+bool RouterEngine::Journey::isPartial() const
+{
+    return m_partial;
+}
+
+void RouterEngine::Journey::setPartial(const bool partial)
+{
+    m_partial = partial;
+}
+
+QList<QUrl> RouterEngine::Journey::pageURIs() const
+{
+    return m_pageURIs;
+}
+
+void RouterEngine::Journey::setPageURIs(const QList<QUrl> &pageURIs)
+{
+    m_pageURIs = pageURIs;
+}
+
+void RouterEngine::Journey::addPageURI(const QUrl &pageURI)
+{
+    if (!m_pageURIs.contains(pageURI)) {
+        m_pageURIs.append(pageURI);
+    }
+}
+
+void RouterEngine::Journey::resizeArrays(const quint32 stationCount, const quint32 tripCount)
+{
+    // Only grow the arrays, identifiers are never removed from the URI index
+    if (static_cast<quint32>(m_SArray.size()) < stationCount) {
+        m_SArray.resize(stationCount);
+        m_STransferIndex.resize(stationCount);
+    }
+
+    if (static_cast<quint32>(m_S_EarliestArrivalTime.size()) < stationCount) {
+        m_S_EarliestArrivalTime.resize(stationCount);
+    }
+
+    if (static_cast<quint32>(m_TArray.size()) < tripCount) {
+        m_TArray.resize(tripCount);
+    }
+
+    if (static_cast<quint32>(m_T_EarliestArrivalTime.size()) < tripCount) {
+        m_T_EarliestArrivalTime.resize(tripCount);
+    }
+}
+
+qint16 RouterEngine::Journey::T_EarliestArrivalTimeAt(const quint32 tripID) const
+{
+    return m_T_EarliestArrivalTime.at(tripID);
+}
+
+void RouterEngine::Journey::setT_EarliestArrivalTimeAt(const quint32 tripID, const qint16 count)
+{
+    if (m_T_EarliestArrivalTime.at(tripID) == count) {
+        return;
+    }
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordT_EarliestArrivalTime(tripID, m_T_EarliestArrivalTime.at(tripID));
+    }
+    m_T_EarliestArrivalTime[tripID] = count;
+}
+
+qint64 RouterEngine::Journey::S_EarliestArrivalTimeAt(const quint32 stationID) const
+{
+    return m_S_EarliestArrivalTime.at(stationID);
+}
+
+void RouterEngine::Journey::setS_EarliestArrivalTimeAt(const quint32 stationID, const qint64 earliestArrivalTime)
+{
+    if (m_S_EarliestArrivalTime.at(stationID) == earliestArrivalTime) {
+        return;
+    }
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordS_EarliestArrivalTime(stationID, m_S_EarliestArrivalTime.at(stationID));
+    }
+    m_S_EarliestArrivalTime[stationID] = earliestArrivalTime;
+}
+
+QSharedPointer<RouterEngine::TrainProfile> RouterEngine::Journey::TArrayAt(const quint32 tripID) const
+{
+    return m_TArray.at(tripID);
+}
+
+void RouterEngine::Journey::setTArrayAt(const quint32 tripID, const QSharedPointer<RouterEngine::TrainProfile> &trainProfile)
+{
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordTArray(tripID, m_TArray.at(tripID));
+    }
+    m_TArray[tripID] = trainProfile;
+}
+
+const QList<QSharedPointer<RouterEngine::StationStopProfile> > &RouterEngine::Journey::SArrayAt(const quint32 stationID) const
+{
+    // Stations which were interned after the last resize don't have any profiles yet
+    static const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > emptyProfiles;
+    if (stationID >= static_cast<quint32>(m_SArray.size())) {
+        return emptyProfiles;
+    }
+    return m_SArray.at(stationID);
+}
+
+void RouterEngine::Journey::appendSArrayAt(const quint32 stationID, const QSharedPointer<RouterEngine::StationStopProfile> &stationStopProfile)
+{
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordSArrayAppend(stationID);
+    }
+    m_SArray[stationID].append(stationStopProfile);
+    m_STransferIndex[stationID].append(-1);
+    this->updateLastSTransferIndex(stationID);
+}
+
+void RouterEngine::Journey::replaceLastSArrayAt(const quint32 stationID, const QSharedPointer<RouterEngine::StationStopProfile> &stationStopProfile)
+{
+    QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &profiles = m_SArray[stationID];
+    if (QRail::RouterEngine::SnapshotJourney *snapshot = this->currentSnapshot()) {
+        snapshot->recordSArrayReplaceLast(stationID, profiles.last());
+    }
+    profiles[profiles.size() - 1] = stationStopProfile;
+    this->updateLastSTransferIndex(stationID);
+}
+
+qint32 RouterEngine::Journey::lastReachableSArrayIndex(const quint32 stationID, const qint64 earliestDepartureTime) const
+{
+    const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &profiles = this->SArrayAt(stationID);
+
+    // The profiles are sorted by DESCENDING departure time, find the first profile which departs too early
+    qint32 low = 0;
+    qint32 high = profiles.size();
+    while (low < high) {
+        qint32 middle = low + (high - low) / 2;
+        if (profiles.at(middle)->departureTime() >= earliestDepartureTime) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // The profile just before it is the earliest reachable departure
+    return low - 1;
+}
+
+qint32 RouterEngine::Journey::lastTransferableSArrayIndex(const quint32 stationID, const qint64 earliestDepartureTime) const
+{
+    // The transfer index points from every reachable profile to the closest one we can still transfer to
+    qint32 position = this->lastReachableSArrayIndex(stationID, earliestDepartureTime);
+    if (position < 0) {
+        return -1;
+    }
+    return m_STransferIndex.at(stationID).at(position);
+}
+
+qint32 RouterEngine::Journey::indexOfSArrayArrivalTime(const quint32 stationID, const qint64 arrivalTime) const
+{
+    const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &profiles = this->SArrayAt(stationID);
+
+    // The profiles are sorted by DESCENDING arrival time
+    qint32 low = 0;
+    qint32 high = profiles.size() - 1;
+    while (low <= high) {
+        qint32 middle = low + (high - low) / 2;
+        qint64 middleArrivalTime = profiles.at(middle)->arrivalTime();
+        if (middleArrivalTime == arrivalTime) {
+            return middle;
+        } else if (middleArrivalTime > arrivalTime) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    return -1;
 }
 
 void RouterEngine::Journey::addSnapshotJourney(RouterEngine::SnapshotJourney *snapshotJourney)
@@ -171,20 +364,22 @@ QDateTime RouterEngine::Journey::restoreBeforePage(const QUrl pageURI)
         QRail::RouterEngine::SnapshotJourney *snapshotJourney = m_snapshotJourneys.at(c);
         qDebug() << snapshotJourney->pageURI().toString();
         if(snapshotJourney->pageURI() == pageURI) {
+            // Undo the changes of this page and every page processed after it, newest first
+            for(qint64 u=m_snapshotJourneys.length() - 1; u >= c; u--) {
+                this->undoSnapshot(m_snapshotJourneys.at(u));
+            }
+
             // There's no journey before the first page used in the journey
             if(c == 0) {
                 qWarning() << "No journey exist before the first page, rerouting completely!";
-                resetJourney();
-                return pageTimestamp;
+                this->setHydraNext(snapshotJourney->hydraNext());
+                this->setHydraPrevious(snapshotJourney->hydraPrevious());
+            }
+            else {
+                QRail::RouterEngine::SnapshotJourney *previousSnapshotJourney = m_snapshotJourneys.at(c-1);
+                this->setHydraNext(previousSnapshotJourney->hydraNext());
+                this->setHydraPrevious(previousSnapshotJourney->hydraPrevious());
             }
-            QRail::RouterEngine::SnapshotJourney *previousSnapshotJourney = m_snapshotJourneys.at(c-1);
-            this->setRoutes(previousSnapshotJourney->routes());
-            this->setTArray(previousSnapshotJourney->TArray());
-            this->setSArray(previousSnapshotJourney->SArray());
-            this->setT_EarliestArrivalTime(previousSnapshotJourney->T_EarliestArrivalTime());
-            this->setS_EarliestArrivalTime(previousSnapshotJourney->S_EarliestArrivalTime());
-            this->setHydraNext(previousSnapshotJourney->hydraNext());
-            this->setHydraPrevious(previousSnapshotJourney->hydraPrevious());
             qDebug() << "Succesfully restored the previous Journey";
             this->cleanSnapshots(snapshotJourney->pageTimestamp());
             return pageTimestamp;
@@ -195,6 +390,47 @@ QDateTime RouterEngine::Journey::restoreBeforePage(const QUrl pageURI)
     return QDateTime();
 }
 
+void RouterEngine::Journey::undoSnapshot(RouterEngine::SnapshotJourney *snapshotJourney)
+{
+    // Replay the changes backwards, the values are written directly to avoid recording them again
+    const QVector<QRail::RouterEngine::SnapshotJourney::Change> &changes = snapshotJourney->changes();
+    for(qint32 i=changes.size() - 1; i >= 0; i--) {
+        const QRail::RouterEngine::SnapshotJourney::Change &change = changes.at(i);
+        switch(change.type) {
+        case QRail::RouterEngine::SnapshotJourney::ChangeType::T_EARLIEST_ARRIVAL_TIME:
+            m_T_EarliestArrivalTime[change.index] = static_cast<qint16>(change.time);
+            break;
+        case QRail::RouterEngine::SnapshotJourney::ChangeType::S_EARLIEST_ARRIVAL_TIME:
+            m_S_EarliestArrivalTime[change.index] = change.time;
+            break;
+        case QRail::RouterEngine::SnapshotJourney::ChangeType::T_ARRAY:
+            m_TArray[change.index] = change.trainProfile;
+            break;
+        case QRail::RouterEngine::SnapshotJourney::ChangeType::S_ARRAY_APPEND:
+            m_SArray[change.index].removeLast();
+            m_STransferIndex[change.index].removeLast();
+            break;
+        case QRail::RouterEngine::SnapshotJourney::ChangeType::S_ARRAY_REPLACE_LAST:
+            m_SArray[change.index].last() = change.stationStopProfile;
+            this->updateLastSTransferIndex(change.index);
+            break;
+        }
+    }
+
+    if(snapshotJourney->hasRoutes()) {
+        m_routes = snapshotJourney->routes();
+    }
+}
+
+QRail::RouterEngine::SnapshotJourney *RouterEngine::Journey::currentSnapshot() const
+{
+    // Changes are only recorded when snapshots are kept for rollback support
+    if(m_snapshotJourneys.isEmpty()) {
+        return nullptr;
+    }
+    return m_snapshotJourneys.last();
+}
+
 void RouterEngine::Journey::cleanSnapshots(QDateTime snapshotTime)
 {
     // Only call this method when the previous journey was restored, otherwise no profiles are deleted!
@@ -215,31 +451,55 @@ qint64 RouterEngine::Journey::snapshotCount()
 void RouterEngine::Journey::resetJourney()
 {
     this->setRoutes(QList<QSharedPointer<QRail::RouterEngine::Route >>());
-    this->setTArray(QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > ());
-    this->setSArray(QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > >());
-    this->setT_EarliestArrivalTime(QMap<QUrl, qint16>());
-    this->setS_EarliestArrivalTime(QMap<QUrl, QDateTime>());
+    this->setTArray(QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > ());
+    this->setSArray(QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > >());
+    this->setT_EarliestArrivalTime(QVector<qint16>());
+    this->setS_EarliestArrivalTime(QVector<qint64>());
     this->setHydraNext(m_snapshotJourneys.at(0)->hydraNext());
     this->setHydraPrevious(m_snapshotJourneys.at(0)->hydraPrevious());
     this->cleanSnapshots(m_snapshotJourneys.at(0)->pageTimestamp());
 }
 
-QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > QRail::RouterEngine::Journey::SArray() const
+QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > QRail::RouterEngine::Journey::SArray() const
 {
     return m_SArray;
 }
 
-void QRail::RouterEngine::Journey::setSArray(const QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > &SArray)
+void QRail::RouterEngine::Journey::setSArray(const QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > &SArray)
 {
     m_SArray = SArray;
+    this->rebuildSTransferIndex();
+}
+
+void QRail::RouterEngine::Journey::updateLastSTransferIndex(const quint32 stationID)
+{
+    // Entry i is the index of the last profile up to i which has less transfers than allowed
+    QVector<qint32> &transferIndex = m_STransferIndex[stationID];
+    qint32 last = transferIndex.size() - 1;
+    if (m_SArray.at(stationID).at(last)->transfers() < m_maxTransfers) {
+        transferIndex[last] = last;
+    } else {
+        transferIndex[last] = last > 0 ? transferIndex.at(last - 1) : -1;
+    }
+}
+
+void QRail::RouterEngine::Journey::rebuildSTransferIndex()
+{
+    m_STransferIndex = QVector<QVector<qint32> >(m_SArray.size());
+    for (qint32 stationID = 0; stationID < m_SArray.size(); stationID++) {
+        for (qint32 i = 0; i < m_SArray.at(stationID).size(); i++) {
+            m_STransferIndex[stationID].append(-1);
+            this->updateLastSTransferIndex(stationID);
+        }
+    }
 }
 
-QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > QRail::RouterEngine::Journey::TArray() const
+QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > QRail::RouterEngine::Journey::TArray() const
 {
     return m_TArray;
 }
 
-void QRail::RouterEngine::Journey::setTArray(const QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > &TArray)
+void QRail::RouterEngine::Journey::setTArray(const QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > &TArray)
 {
     m_TArray = TArray;
 }
@@ -254,12 +514,12 @@ void QRail::RouterEngine::Journey::setDepartureStationURI(const QUrl &departureS
     m_departureStationURI = departureStationURI;
 }
 
-QMap<QUrl, qint16> QRail::RouterEngine::Journey::T_EarliestArrivalTime() const
+QVector<qint16> QRail::RouterEngine::Journey::T_EarliestArrivalTime() const
 {
     return m_T_EarliestArrivalTime;
 }
 
-void QRail::RouterEngine::Journey::setT_EarliestArrivalTime(const QMap<QUrl, qint16> &T_EarliestArrivalTime)
+void QRail::RouterEngine::Journey::setT_EarliestArrivalTime(const QVector<qint16> &T_EarliestArrivalTime)
 {
     m_T_EarliestArrivalTime = T_EarliestArrivalTime;
 }
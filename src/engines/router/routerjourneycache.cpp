@@ -0,0 +1,213 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "engines/router/routerjourneycache.h"
+using namespace QRail;
+
+QRail::RouterEngine::JourneyCache::JourneyCache(QObject *parent) : QObject(parent)
+{
+    m_entries = QHash<QString, QRail::RouterEngine::JourneyCache::Entry>();
+    m_order = QList<QString>();
+    m_dependents = QHash<QUrl, QSet<QString> >();
+    m_maxSize = JOURNEY_CACHE_SIZE;
+    m_bucketSize = JOURNEY_CACHE_BUCKET_SIZE;
+}
+
+QList<QSharedPointer<QRail::RouterEngine::Route> > QRail::RouterEngine::JourneyCache::routes(const QRail::RouterEngine::Query &query, bool *ok)
+{
+    QMutexLocker locker(&m_mutex);
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+    if (ok) {
+        *ok = false;
+    }
+
+    // The bucket only narrows the search, the cached window must cover the requested one
+    QString key = this->key(query.departureStation(), query.arrivalStation(), query.departureTime(), query.latestDepartureTime(), query.maxTransfers());
+    if (!m_entries.contains(key) || !this->covers(m_entries.value(key), query.departureTime(), query.latestDepartureTime())) {
+        return routes;
+    }
+
+    // Routes departing before the requested departure time are part of the same bucket
+    foreach (QSharedPointer<QRail::RouterEngine::Route> route, m_entries.value(key).routes) {
+        if (query.isInDepartureWindow(route->departureTime())) {
+            routes.append(route);
+        }
+    }
+
+    // Nothing left in the requested window, let the planner look further
+    if (routes.isEmpty()) {
+        return routes;
+    }
+
+    // Most recently used Journeys are evicted last
+    m_order.removeOne(key);
+    m_order.append(key);
+    qDebug() << "Journey cache hit:" << key;
+    if (ok) {
+        *ok = true;
+    }
+    return routes;
+}
+
+void QRail::RouterEngine::JourneyCache::insert(QRail::RouterEngine::Journey *journey)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!journey || m_maxSize <= 0) {
+        return;
+    }
+
+    // Keep the cached Journey when it answers every query this Journey answers
+    QString key = this->key(journey->departureStationURI(), journey->arrivalStationURI(), journey->departureTime(), journey->latestDepartureTime(), journey->maxTransfers());
+    if (m_entries.contains(key) && this->covers(m_entries.value(key), journey->departureTime(), journey->latestDepartureTime())) {
+        return;
+    }
+    this->remove(key);
+    while (m_order.size() >= m_maxSize) {
+        this->remove(m_order.first());
+    }
+
+    // The Journey depends on the scanned pages and the connections of its routes
+    QRail::RouterEngine::JourneyCache::Entry entry;
+    entry.routes = journey->routes();
+    entry.departureTime = journey->departureTime();
+    entry.latestDepartureTime = journey->latestDepartureTime();
+    entry.dependencies = journey->pageURIs();
+    foreach (QSharedPointer<QRail::RouterEngine::Route> route, entry.routes) {
+        foreach (QSharedPointer<QRail::RouterEngine::RouteLeg> leg, route->legs()) {
+            entry.dependencies.append(leg->departure()->uri());
+            entry.dependencies.append(leg->arrival()->uri());
+        }
+    }
+
+    foreach (QUrl uri, entry.dependencies) {
+        m_dependents[uri].insert(key);
+    }
+    m_entries.insert(key, entry);
+    m_order.append(key);
+}
+
+void QRail::RouterEngine::JourneyCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_order.clear();
+    m_dependents.clear();
+}
+
+qint32 QRail::RouterEngine::JourneyCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+qint32 QRail::RouterEngine::JourneyCache::maxSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxSize;
+}
+
+void QRail::RouterEngine::JourneyCache::setMaxSize(const qint32 maxSize)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxSize = maxSize;
+    while (m_order.size() > qMax(maxSize, 0)) {
+        this->remove(m_order.first());
+    }
+}
+
+qint32 QRail::RouterEngine::JourneyCache::bucketSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bucketSize;
+}
+
+void QRail::RouterEngine::JourneyCache::setBucketSize(const qint32 bucketSize)
+{
+    // Keys of the cached Journeys depend on the bucket size
+    QMutexLocker locker(&m_mutex);
+    m_bucketSize = qMax(bucketSize, 1);
+    m_entries.clear();
+    m_order.clear();
+    m_dependents.clear();
+}
+
+void QRail::RouterEngine::JourneyCache::invalidatePage(const QUrl &pageURI)
+{
+    QMutexLocker locker(&m_mutex);
+    this->invalidate(pageURI);
+}
+
+void QRail::RouterEngine::JourneyCache::invalidateFragment(QSharedPointer<QRail::Fragments::Fragment> fragment)
+{
+    QMutexLocker locker(&m_mutex);
+    this->invalidate(fragment->uri());
+}
+
+// Helpers
+QString QRail::RouterEngine::JourneyCache::key(const QUrl &departureStation,
+                                               const QUrl &arrivalStation,
+                                               const QDateTime &departureTime,
+                                               const QDateTime &latestDepartureTime,
+                                               const qint32 maxTransfers) const
+{
+    // Range queries are only answered by Journeys with the same departure time window
+    qint64 bucket = departureTime.toMSecsSinceEpoch() / 1000 / m_bucketSize;
+    qint64 latestBucket = latestDepartureTime.isValid()? latestDepartureTime.toMSecsSinceEpoch() / 1000 / m_bucketSize: -1;
+    return QString("%1|%2|%3|%4|%5").arg(departureStation.toString())
+           .arg(arrivalStation.toString())
+           .arg(bucket)
+           .arg(latestBucket)
+           .arg(maxTransfers);
+}
+
+bool QRail::RouterEngine::JourneyCache::covers(const QRail::RouterEngine::JourneyCache::Entry &entry,
+                                               const QDateTime &departureTime,
+                                               const QDateTime &latestDepartureTime) const
+{
+    // A single departure Journey only keeps the routes for its own departure time, later departures may be missing
+    if (!latestDepartureTime.isValid()) {
+        return entry.departureTime == departureTime && !entry.latestDepartureTime.isValid();
+    }
+    return entry.departureTime <= departureTime && entry.latestDepartureTime.isValid() && entry.latestDepartureTime >= latestDepartureTime;
+}
+
+void QRail::RouterEngine::JourneyCache::invalidate(const QUrl &uri)
+{
+    if (!m_dependents.contains(uri)) {
+        return;
+    }
+
+    foreach (QString key, m_dependents.value(uri)) {
+        qDebug() << "Journey cache eviction:" << key << "updated:" << uri;
+        this->remove(key);
+    }
+}
+
+void QRail::RouterEngine::JourneyCache::remove(const QString &key)
+{
+    if (!m_entries.contains(key)) {
+        return;
+    }
+
+    // Only visit the URIs this Journey depends on
+    foreach (QUrl uri, m_entries.take(key).dependencies) {
+        m_dependents[uri].remove(key);
+        if (m_dependents.value(uri).isEmpty()) {
+            m_dependents.remove(uri);
+        }
+    }
+    m_order.removeOne(key);
+}
@@ -26,8 +26,26 @@ QRail::RouterEngine::Planner::Planner(QRail::Network::EventSource::Subscription
     this->setAbortRequested(false);
     this->progressTimeoutTimer = new QTimer(this);
     this->progressTimeoutTimer->setInterval(HTTP_TIMEOUT);
+    this->updateCoalescingTimer = new QTimer(this);
+    this->updateCoalescingTimer->setSingleShot(true);
+    this->updateCoalescingTimer->setInterval(UPDATE_COALESCING_INTERVAL);
+    this->deadlineTimer = new QTimer(this);
+    this->deadlineTimer->setSingleShot(true);
     m_isRunning = false;
+    m_queryGeneration = 0;
+    m_journey = nullptr;
+    m_prefetchDepth = DEFAULT_PREFETCH_DEPTH;
+    m_forwardSearchEnabled = true;
+    m_geographicPruningEnabled = false;
+    m_forwardSearch = false;
+    m_incrementalUpdatesEnabled = true;
+    m_backgroundUpdatesEnabled = true;
+    m_timer = nullptr;
+    m_updateCoalescingInterval = UPDATE_COALESCING_INTERVAL;
+    m_destinationCache = new QRail::RouterEngine::DestinationCache(this);
+    m_journeyCache = new QRail::RouterEngine::JourneyCache(this);
     m_watchList = QList<QRail::RouterEngine::Journey *>();
+    m_pinnedPages = QHash<QRail::RouterEngine::Journey *, QList<QUrl> >();
     m_subscriptionType = subscriptionType;
 
     if(m_subscriptionType == QRail::Network::EventSource::Subscription::NONE) {
@@ -38,12 +56,19 @@ QRail::RouterEngine::Planner::Planner(QRail::Network::EventSource::Subscription
 
     // Connect signals
     connect(this, SIGNAL(finished(QRail::RouterEngine::Journey*)), this, SLOT(unlockPlanner()));
+    connect(this, SIGNAL(batchFinished()), this, SLOT(unlockPlanner()));
     connect(this->progressTimeoutTimer, SIGNAL(timeout()), this, SLOT(handleTimeout()));
     connect(this->fragmentsFactory(), SIGNAL(fragmentAndPageUpdated(QSharedPointer<QRail::Fragments::Fragment>, QUrl)),
             this, SLOT(handleFragmentAndPageFactoryUpdate(QSharedPointer<QRail::Fragments::Fragment>, QUrl)));
-    connect(this->fragmentsFactory(), SIGNAL(updateProcessed(qint64)), this, SLOT(processUpdate()));
+    connect(this->fragmentsFactory(), SIGNAL(updateProcessed(qint64)), this, SLOT(scheduleUpdate()));
+    connect(this->fragmentsFactory(), SIGNAL(pageUpdated(QUrl)), this->journeyCache(), SLOT(invalidatePage(QUrl)));
+    connect(this->fragmentsFactory(), SIGNAL(fragmentUpdated(QSharedPointer<QRail::Fragments::Fragment>)),
+            this->journeyCache(), SLOT(invalidateFragment(QSharedPointer<QRail::Fragments::Fragment>)));
+    connect(this->updateCoalescingTimer, SIGNAL(timeout()), this, SLOT(processUpdate()));
+    connect(this->deadlineTimer, SIGNAL(timeout()), this, SLOT(handleDeadline()));
     connect(this->fragmentsFactory(), SIGNAL(updateReceived(qint64)), this, SIGNAL(updateReceived(qint64)));
-    connect(this->fragmentsFactory(), SIGNAL(pageReady(QSharedPointer<QRail::Fragments::Page>)), this, SLOT(processPage(QSharedPointer<QRail::Fragments::Page>)));
+    connect(this->fragmentsFactory(), SIGNAL(pageDispatched(QSharedPointer<QRail::Fragments::Page>, QObject*, quint64)),
+            this, SLOT(processPage(QSharedPointer<QRail::Fragments::Page>, QObject*, quint64)));
 }
 
 QRail::RouterEngine::Planner *QRail::RouterEngine::Planner::getInstance(QRail::Network::EventSource::Subscription subscriptionType)
@@ -60,7 +85,8 @@ QRail::RouterEngine::Planner *QRail::RouterEngine::Planner::getInstance(QRail::N
 void QRail::RouterEngine::Planner::getConnections(const QUrl &departureStation,
                                                   const QUrl &arrivalStation,
                                                   const QDateTime &departureTime,
-                                                  const quint16 &maxTransfers)
+                                                  const quint16 &maxTransfers,
+                                                  const qint32 &deadline)
 {
     /*
     * The CSA algorithm is based on the Connection Scan Algorithm paper, March
@@ -90,54 +116,142 @@ void QRail::RouterEngine::Planner::getConnections(const QUrl &departureStation,
     * https://stackoverflow.com/questions/7114421/qtconcurrentrun-emit-signal#41110098
     * Docs: https://doc.qt.io/qt-5.6/qtconcurrent.html
     */
+    this->getConnections(QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, maxTransfers), deadline);
+}
+
+void QRail::RouterEngine::Planner::getConnections(const QRail::RouterEngine::Query &query, const qint32 &deadline)
+{
     m_isRunning = true;
 
-    if (departureStation.isValid() && arrivalStation.isValid() && departureStation.isValid()) {
+    if (query.isValid()) {
         qDebug() << "Init CSA algorithm";
         if(!plannerProcessingMutex.tryLock(LOCK_TIMEOUT)) {
             emit this->error("Planner factory is busy. Please try again later.");
             return;
         }
 
-        // Init
+        // Init, pages requested by previous operations are dropped from now on
+        m_queryGeneration++;
         this->setAbortRequested(false);
-        this->setJourney(new QRail::RouterEngine::Journey(this));
-        this->journey()->setTArray(QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> >());
-        this->journey()->setSArray(QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > >());
-        this->journey()->setDepartureStationURI(departureStation);
-        this->journey()->setArrivalStationURI(arrivalStation);
-        this->journey()->setDepartureTime(departureTime);
-        this->journey()->setArrivalTime(this->calculateArrivalTime(this->journey()->departureTime()));
-        this->journey()->setMaxTransfers(maxTransfers);
-        this->journey()->setRoutes(QList<QSharedPointer<QRail::RouterEngine::Route> >());
-        this->journey()->setT_EarliestArrivalTime(QMap<QUrl, qint16>());
-        QMap<QUrl, QDateTime> S_early = QMap<QUrl, QDateTime>();
-        S_early.insert(this->journey()->arrivalStationURI(), this->journey()->arrivalTime());
-        this->journey()->setS_EarliestArrivalTime(S_early);
+        m_forwardSearch = false;
+
+        // Same query answered recently and none of its pages changed since
+        this->setJourney(this->createJourney(query));
+        bool isCached = false;
+        QList<QSharedPointer<QRail::RouterEngine::Route> > cachedRoutes = this->journeyCache()->routes(query, &isCached);
+        if (isCached) {
+            this->journey()->setRoutes(cachedRoutes);
+            this->finishJourney();
+            return;
+        }
+
         this->progressTimeoutTimer->start();
 
+        // Interactive clients prefer a partial result over waiting for the complete one
+        if (deadline > 0) {
+            this->deadlineTimer->start(deadline);
+        }
+
+        // Profiles towards this destination are known already, no page is needed
+        if (this->answerFromDestinationCache()) {
+            return;
+        }
+
+        // Find a tight arrival time bound first by scanning forward from the (latest) departure time
+        if (this->isForwardSearchEnabled()) {
+            m_forwardSearch = true;
+            m_forwardArrivalTimes.clear();
+            m_forwardReachedTrips.clear();
+            this->requestPage(this->forwardSearchDepartureTime());
+            qDebug() << "CSA init OK, forward Earliest Arrival search started";
+            return;
+        }
+
         // Jumpstart the page fetching
-        this->fragmentsFactory()->getPage(this->journey()->arrivalTime());
+        this->requestPage(this->journey()->arrivalTime());
         qDebug() << "CSA init OK";
     } else {
         qCritical() << "Invalid stations or timestamps";
-        qCritical() << "Departure station:" << departureStation;
-        qCritical() << "Arrival station:" << arrivalStation;
-        qCritical() << "Departure time:" << departureTime;
+        qCritical() << "Departure station:" << query.departureStation();
+        qCritical() << "Arrival station:" << query.arrivalStation();
+        qCritical() << "Departure time:" << query.departureTime();
+        qCritical() << "Latest departure time:" << query.latestDepartureTime();
+    }
+}
+
+void QRail::RouterEngine::Planner::getConnections(const QList<QRail::RouterEngine::Query> &queries)
+{
+    /*
+    * Batch mode: every Linked Connections page is fetched and parsed once
+    * and the connections are scanned for each Journey of the batch.
+    * The pages are fetched from the latest arrival time of the batch
+    * until every Journey passed its departure time limit.
+    */
+    if (queries.isEmpty()) {
+        qCritical() << "Empty batch of queries";
+        emit this->error("No queries given!");
+        return;
+    }
+
+    foreach (QRail::RouterEngine::Query query, queries) {
+        if (!query.isValid()) {
+            qCritical() << "Invalid stations or timestamps in batch";
+            qCritical() << "Departure station:" << query.departureStation();
+            qCritical() << "Arrival station:" << query.arrivalStation();
+            qCritical() << "Departure time:" << query.departureTime();
+            emit this->error("Invalid query in batch!");
+            return;
+        }
+    }
+
+    qDebug() << "Init CSA algorithm for a batch of" << queries.size() << "queries";
+    if(!plannerProcessingMutex.tryLock(LOCK_TIMEOUT)) {
+        emit this->error("Planner factory is busy. Please try again later.");
+        return;
     }
+
+    // Init, pages requested by previous operations are dropped from now on
+    m_isRunning = true;
+    m_queryGeneration++;
+    this->setAbortRequested(false);
+    m_forwardSearch = false;
+    m_batchJourneys.clear();
+    m_batchFinished.clear();
+    QDateTime arrivalTime;
+    foreach (QRail::RouterEngine::Query query, queries) {
+        QRail::RouterEngine::Journey *journey = this->createJourney(query);
+        m_batchJourneys.append(journey);
+        m_batchFinished.append(false);
+        if (!arrivalTime.isValid() || journey->arrivalTime() > arrivalTime) {
+            arrivalTime = journey->arrivalTime();
+        }
+    }
+    this->progressTimeoutTimer->start();
+
+    // Jumpstart the page fetching at the latest arrival time of the batch
+    this->requestPage(arrivalTime);
+    qDebug() << "CSA batch init OK";
 }
 
 void RouterEngine::Planner::getConnections(Journey *journey, QDateTime pageTimestamp)
 {
     if(journey) {
+        // Rerouting uses the same Planner state as a new query
+        if(!plannerProcessingMutex.tryLock(LOCK_TIMEOUT)) {
+            emit this->error("Planner factory is busy. Please try again later.");
+            return;
+        }
+
         m_isRunning = true;
+        m_queryGeneration++;
+        m_forwardSearch = false;
         this->setJourney(journey);
         this->progressTimeoutTimer->start();
 
         // Jumpstart the page fetching
         qDebug() << "************************ REROUTING JOURNEY *****************************";
 
-        this->fragmentsFactory()->getPage(pageTimestamp);
+        this->requestPage(pageTimestamp);
         qDebug() << "CSA init OK";
     }
     else {
@@ -149,12 +263,13 @@ void RouterEngine::Planner::getConnections(Journey *journey, QDateTime pageTimes
 void RouterEngine::Planner::getConnections(const QGeoCoordinate &departurePosition,
                                            const QGeoCoordinate &arrivalPosition,
                                            const QDateTime &departureTime,
-                                           const quint16 &maxTransfers)
+                                           const quint16 &maxTransfers,
+                                           const qint32 &deadline)
 {
     if (departurePosition.isValid() && arrivalPosition.isValid() && departureTime.isValid()) {
         QUrl departureStationURI = this->stationFactory()->getNearestStationByPosition(departurePosition, SEARCH_RADIUS).first->uri();
         QUrl arrivalStationURI = this->stationFactory()->getNearestStationByPosition(arrivalPosition, SEARCH_RADIUS).first->uri();
-        this->getConnections(departureStationURI, arrivalStationURI, departureTime, maxTransfers);
+        this->getConnections(departureStationURI, arrivalStationURI, departureTime, maxTransfers, deadline);
     } else {
         qCritical() << "Invalid positions or timestamps";
         qCritical() << "Departure position:" << departurePosition;
@@ -179,12 +294,313 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
 
     // Flag to check if we're passed the departureTime
     bool hasPassedDepartureTimeLimit = false;
+    if(!this->scanPage(page, this->journey(), hasPassedDepartureTimeLimit)) {
+        this->setAbortRequested(false);
+        emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
+        qInfo() << "Aborted successfully in FOR loop";
+        return;
+    }
+
+    /*
+    * ===========================
+    *         CLEANING UP
+    * ===========================
+    * In case we haven't found any results, we load more data or
+    * stop if we passed the departure time limit (see hasPassedDepartureTimeLimit
+    * flag).
+    */
+
+    // No results found, load more data if needed or return empty list
+    if (hasPassedDepartureTimeLimit) {
+        qDebug() << "Departure time limit passed, wrapping up";
+
+        // Keep the profiles towards this destination for the next queries
+        this->cacheDestinationProfile(this->journey());
+        this->finishJourney();
+    }
+}
+
+void QRail::RouterEngine::Planner::finishJourney()
+{
+    // Emit the error signal when we haven't found any routes
+    if (this->journey()->routes().size() == 0) {
+        emit this->error("No routes found!");
+        emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
+        return;
+    }
+
+    // Index the routes for real time updates, partial results aren't reused for other queries
+    this->indexJourney(this->journey());
+    if (!this->journey()->isPartial()) {
+        this->journeyCache()->insert(this->journey());
+    }
+
+    // Emit finished signal when we completely parsed and processed all Linked Connections pages
+    emit this->finished(this->journey());
+}
+
+void QRail::RouterEngine::Planner::cacheDestinationProfile(QRail::RouterEngine::Journey *journey)
+{
+    if (this->destinationCacheSize() <= 0) {
+        return;
+    }
+
+    QRail::RouterEngine::DestinationCache::Profile profile;
+    profile.departureTime = journey->departureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    profile.arrivalTime = journey->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    profile.maxTransfers = journey->maxTransfers();
+    profile.updateVersion = this->fragmentsFactory()->updateVersion();
+    profile.SArray = journey->SArray();
+    profile.pageURIs = journey->pageURIs();
+    this->destinationCache()->insert(journey->arrivalStationURI(), profile);
+}
+
+bool QRail::RouterEngine::Planner::answerFromDestinationCache()
+{
+    /*
+    * The Profile CSA computes the S array towards the destination for every
+    * station, not only for the requested departure station. A cached profile
+    * answers a query from any departure station when:
+    *   - no real time update happened since it was computed
+    *   - the maximum amount of transfers is the same
+    *   - the requested departure and arrival times are inside its window
+    * Only the routes need to be extracted in that case.
+    *
+    * The cache is checked before the forward search fetches any page. The
+    * cached profiles of the departure station give the earliest arrival time
+    * including transfers, the arrival time bound derived from it is never
+    * tighter than the one the forward search would find.
+    */
+    QRail::RouterEngine::Journey *journey = this->journey();
+    QRail::RouterEngine::DestinationCache::Profile profile;
+    if (!this->destinationCache()->profile(journey->arrivalStationURI(), this->fragmentsFactory()->updateVersion(), &profile)) {
+        return false;
+    }
+
+    const qint64 departureTime = journey->departureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    qint64 arrivalTime = journey->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    if (profile.maxTransfers != journey->maxTransfers() || departureTime < profile.departureTime) {
+        return false;
+    }
+
+    QRail::Fragments::URIIndex *stationIndex = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION);
+    quint32 departureStationID = stationIndex->intern(journey->departureStationURI());
+    quint32 arrivalStationID = stationIndex->intern(journey->arrivalStationURI());
+    if (this->isForwardSearchEnabled()) {
+        // Profiles are sorted by DESCENDING departure and arrival times, the last one departing in time arrives first
+        const qint64 searchDepartureTime = this->forwardSearchDepartureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+        qint64 earliestArrivalTime = 0;
+        if (departureStationID < static_cast<quint32>(profile.SArray.size())) {
+            foreach (QSharedPointer<QRail::RouterEngine::StationStopProfile> stationProfile, profile.SArray.at(departureStationID)) {
+                if (stationProfile->departureTime() < searchDepartureTime) {
+                    break;
+                }
+                earliestArrivalTime = stationProfile->arrivalTime();
+            }
+        }
+
+        // Destination not reachable with the cached profiles, the forward search has to find the bound
+        if (earliestArrivalTime == 0) {
+            return false;
+        }
+
+        if (earliestArrivalTime + FORWARD_SEARCH_SLACK < arrivalTime) {
+            arrivalTime = earliestArrivalTime + FORWARD_SEARCH_SLACK;
+        }
+    }
+    if (arrivalTime > profile.arrivalTime) {
+        return false;
+    }
+
+    qDebug() << "Destination profile cache hit for" << journey->arrivalStationURI();
+    journey->setArrivalTime(QDateTime::fromMSecsSinceEpoch(arrivalTime * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC));
+    journey->setSArray(profile.SArray);
+    journey->setPageURIs(profile.pageURIs);
+    journey->resizeArrays(stationIndex->count(), QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP)->count());
+    this->extractRoutes(journey, departureStationID, arrivalStationID);
+    this->finishJourney();
+    return true;
+}
+
+void QRail::RouterEngine::Planner::processForwardPage(QSharedPointer<QRail::Fragments::Page> page)
+{
+    /*
+    * Earliest Arrival Connection Scan, section 3 of the CSA paper.
+    * The pages are scanned forward from the departure time until the arrival
+    * station is reached. Transfer times are ignored, the resulting arrival
+    * time is a lower bound of the arrival time of every route.
+    * The profile scan starts at this bound plus a slack window instead of the
+    * guess from calculateArrivalTime.
+    */
+    QMutexLocker locker(&syncThreadMutex);
+
+    if (this->isAbortRequested()) {
+        m_forwardSearch = false;
+        this->setAbortRequested(false);
+        emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
+        qInfo() << "Aborted successfully in forward search";
+        return;
+    }
+
+    // Keep the next pages in flight while this page is scanned
+    if (this->prefetchDepth() > 0) {
+        this->prefetchPages(page->hydraNext(), QRail::Fragments::Factory::Direction::NEXT);
+    }
+
+    QRail::Fragments::URIIndex *stationIndex = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION);
+    QRail::Fragments::URIIndex *tripIndex = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP);
+    quint32 departureStationID = stationIndex->intern(this->journey()->departureStationURI());
+    quint32 arrivalStationID = stationIndex->intern(this->journey()->arrivalStationURI());
+    const qint64 journeyDepartureTime = this->forwardSearchDepartureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+
+    // Arrival times are 0 for stations which aren't reached yet
+    m_forwardArrivalTimes.resize(static_cast<qint32>(stationIndex->count()));
+    m_forwardReachedTrips.resize(static_cast<qint32>(tripIndex->count()));
+    m_forwardArrivalTimes[departureStationID] = journeyDepartureTime;
+
+    // Connections are sorted by ASCENDING departure time
+    QSharedPointer<QRail::Fragments::ConnectionTable> table = page->connectionTable();
+    const QVector<quint32> &departureStationIDs = table->departureStationIDs();
+    const QVector<quint32> &arrivalStationIDs = table->arrivalStationIDs();
+    const QVector<quint32> &tripIDs = table->tripIDs();
+    const QVector<qint64> &departureTimes = table->departureTimes();
+    const QVector<qint64> &arrivalTimes = table->arrivalTimes();
+    for (qint32 row = 0; row < table->size(); row++) {
+        if (departureTimes.at(row) < journeyDepartureTime) {
+            continue;
+        }
+
+        quint32 departureID = departureStationIDs.at(row);
+        quint32 tripID = tripIDs.at(row);
+        qint64 departureStationTime = m_forwardArrivalTimes.at(departureID);
+        if (m_forwardReachedTrips.at(tripID)
+                || (departureStationTime > 0 && departureStationTime <= departureTimes.at(row))) {
+            m_forwardReachedTrips[tripID] = true;
+            quint32 arrivalID = arrivalStationIDs.at(row);
+            if (m_forwardArrivalTimes.at(arrivalID) == 0 || arrivalTimes.at(row) < m_forwardArrivalTimes.at(arrivalID)) {
+                m_forwardArrivalTimes[arrivalID] = arrivalTimes.at(row);
+            }
+        }
+    }
 
-    // Fake an infinite time by adding 1 year to the current date, this is required for the Profile Scan Algortihm to work
-    QDateTime INFINITE_TIME = QDateTime(QDateTime::currentDateTimeUtc().addYears(1));
+    // Arrival station reached, start the profile scan from the bound
+    qint64 earliestArrivalTime = m_forwardArrivalTimes.at(arrivalStationID);
+    if (earliestArrivalTime > 0) {
+        qint64 arrivalTimeBound = earliestArrivalTime + FORWARD_SEARCH_SLACK;
+        qint64 guessedArrivalTime = this->journey()->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+        if (arrivalTimeBound < guessedArrivalTime) {
+            this->journey()->setArrivalTime(QDateTime::fromMSecsSinceEpoch(arrivalTimeBound * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC));
+            this->journey()->setS_EarliestArrivalTimeAt(arrivalStationID, arrivalTimeBound);
+        }
+#ifdef VERBOSE_PARAMETERS
+        qDebug() << "Forward search reached the arrival station at"
+                 << QDateTime::fromMSecsSinceEpoch(earliestArrivalTime * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC)
+                 << "arrival time bound:" << this->journey()->arrivalTime();
+#endif
+        this->startProfileScan();
+        return;
+    }
+
+    // Passed the guessed arrival time without reaching the arrival station, fall back on the guess
+    if (table->size() > 0 && departureTimes.at(table->size() - 1) > this->journey()->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER) {
+        qDebug() << "Forward search passed the guessed arrival time, using the guess";
+        this->startProfileScan();
+        return;
+    }
+
+    // Arrival station not reached yet, fetch the next page
+    if (table->size() <= 0) {
+        qCritical() << "Page" << page->uri() << "is empty, no fragments available!";
+    }
+    this->requestPage(page->hydraNext());
+    emit this->requested(page->hydraNext());
+}
+
+void QRail::RouterEngine::Planner::startProfileScan()
+{
+    // Forward search state isn't needed anymore
+    m_forwardSearch = false;
+    m_forwardArrivalTimes.clear();
+    m_forwardReachedTrips.clear();
+
+    // Jumpstart the page fetching
+    this->requestPage(this->journey()->arrivalTime());
+}
+
+void QRail::RouterEngine::Planner::parseBatchPage(QSharedPointer<QRail::Fragments::Page> page)
+{
+    qDebug() << "parseBatchPage()";
+    // Lock processing to enforce the DESCENDING order of departure times
+    QMutexLocker locker(&syncThreadMutex);
+
+    // The page is shared by all the unfinished Journeys of the batch
+    for (qint32 queryIndex = 0; queryIndex < m_batchJourneys.size(); queryIndex++) {
+        if (m_batchFinished.at(queryIndex)) {
+            continue;
+        }
+
+        bool hasPassedDepartureTimeLimit = false;
+        if(!this->scanPage(page, m_batchJourneys.at(queryIndex), hasPassedDepartureTimeLimit)) {
+            this->setAbortRequested(false);
+            this->finishBatch();
+            qInfo() << "Aborted batch successfully in FOR loop";
+            return;
+        }
+
+        // This Journey is complete, the other Journeys might need more pages
+        if (hasPassedDepartureTimeLimit) {
+            qDebug() << "Departure time limit passed for query" << queryIndex;
+            m_batchFinished[queryIndex] = true;
+            if (m_batchJourneys.at(queryIndex)->routes().size() > 0) {
+                this->journeyCache()->insert(m_batchJourneys.at(queryIndex));
+            }
+            emit this->batchJourneyFinished(queryIndex, m_batchJourneys.at(queryIndex));
+        }
+    }
+
+    if (!m_batchFinished.contains(false)) {
+        qDebug() << "Departure time limit passed for every query, wrapping up";
+        this->finishBatch();
+    }
+}
 
-    // Fake an infinite number of transfers by setting it to 32767 (16 bits signed 01111111 11111111)
-    qint16 INFINITE_TRANSFERS = 32767;
+void QRail::RouterEngine::Planner::finishBatch()
+{
+    // Journeys are owned by the Planner and stay valid after the batch is finished
+    m_batchJourneys.clear();
+    m_batchFinished.clear();
+    emit this->batchFinished();
+}
+
+/*
+ * Runs the Profile Connection Scan Algorithm for a single Journey on the given page.
+ * The page can be shared by several Journeys, only the S and T arrays of the given Journey are modified.
+ * Returns false when the operation has been aborted by the user.
+ */
+bool QRail::RouterEngine::Planner::scanPage(QSharedPointer<QRail::Fragments::Page> page,
+                                            QRail::RouterEngine::Journey *journey,
+                                            bool &hasPassedDepartureTimeLimit)
+{
+    // Flag to check if we're passed the departureTime
+    hasPassedDepartureTimeLimit = false;
+
+    // The S and T arrays are flat arrays indexed by the interned station and trip URIs
+    quint32 departureStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(journey->departureStationURI());
+    quint32 arrivalStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(journey->arrivalStationURI());
+    journey->resizeArrays(QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->count(),
+                          QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP)->count());
+
+    // Results of the Journey are outdated when this page is updated
+    journey->addPageURI(page->uri());
+
+    // Record the changes of this page in a snapshot for rollback support
+    if(m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
+        QRail::RouterEngine::SnapshotJourney *snapshotJourney = new QRail::RouterEngine::SnapshotJourney(page->uri(),
+                                                                                                         journey->hydraNext(),
+                                                                                                         journey->hydraPrevious(),
+                                                                                                         journey);
+        journey->addSnapshotJourney(snapshotJourney);
+    }
 
 #ifdef VERBOSE_PARAMETERS
     qDebug() << "Planning Linked Connections page:";
@@ -192,9 +608,9 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
     qDebug() << "\thydraPrevious:" << page->hydraPrevious();
     qDebug() << "\thydraNext:" << page->hydraNext();
     qDebug() << "Parameters:";
-    qDebug() << "\tDeparture time:" << this->journey()->departureTime();
-    qDebug() << "\tArrival time:" << this->journey()->arrivalTime();
-    qDebug() << "\tmaxTransfers:" << this->journey()->maxTransfers();
+    qDebug() << "\tDeparture time:" << journey->departureTime();
+    qDebug() << "\tArrival time:" << journey->arrivalTime();
+    qDebug() << "\tmaxTransfers:" << journey->maxTransfers();
 #endif
 
     // Check if the connections are reachable in the first place using Earliest Arrival Connection Scan reverse
@@ -210,17 +626,37 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
      * to reduce the number of connections to scan (which reduces the processing time by roughly 15 - 21 %).
      */
 
+    // Scan the columns of the connection table instead of the Fragment objects, they're only needed to build the profiles
+    QSharedPointer<QRail::Fragments::ConnectionTable> table = page->connectionTable();
+    const QVector<quint32> &departureStationIDs = table->departureStationIDs();
+    const QVector<quint32> &arrivalStationIDs = table->arrivalStationIDs();
+    const QVector<quint32> &tripIDs = table->tripIDs();
+    const QVector<qint64> &departureTimes = table->departureTimes();
+    const QVector<qint64> &arrivalTimes = table->arrivalTimes();
+    const QVector<quint8> &pickupTypes = table->pickupTypes();
+    const QVector<quint8> &dropOffTypes = table->dropOffTypes();
+    const quint8 REGULAR = static_cast<quint8>(QRail::Fragments::Fragment::GTFSTypes::REGULAR);
+    const qint64 journeyDepartureTime = journey->departureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    const qint64 journeyArrivalTime = journey->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    const QVector<qint64> *lowerBounds = nullptr;
+    if (this->isGeographicPruningEnabled()) {
+        lowerBounds = &this->lowerBounds(arrivalStationID);
+    }
+
+    /*
+     * Single pass over the table in DESCENDING departure times order.
+     * Reachable connections are appended to the rows list, which keeps the same order for the Profile CSA.
+     * Unreachable connections are simply not copied, we never have to remove anything from the list.
+     */
     bool reachable;
-    QList<QSharedPointer<QRail::Fragments::Fragment>> frags = page->fragments();
-    for (qint16 fragIndex = frags.size() - 1; fragIndex >= 0; --fragIndex) {
+    QVector<qint32> rows;
+    rows.reserve(table->size());
+    for (qint32 row = table->size() - 1; row >= 0; --row) {
         reachable = true; // We assume that everything is reachable until we prove otherwise
 
         // Current operation aborted by the user
         if(this->isAbortRequested()) {
-            this->setAbortRequested(false);
-            emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
-            qInfo() << "Aborted successfully in FOR loop";
-            return;
+            return false;
         }
 
         // Cancelations are removed or the type of the connection is changed, NOT IMPLEMENTED IN UPSTREAM YET [TODO]
@@ -230,32 +666,35 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
          * In order to arrive at our destination, we should be able to get off the vehicle at the arrival station (dropOff type == GTFSTypes::REGULAR).
          * Connections that don't arrive and departure at a stop can't be used either.
          */
-        QSharedPointer<QRail::Fragments::Fragment> fragment = frags.at(fragIndex);
         // You must be able to hop on a train at your departure station. The train must pick up passengers there. If not, discard fragment
-        if(this->journey()->departureStationURI() == fragment->departureStationURI() && fragment->pickupType() != QRail::Fragments::Fragment::GTFSTypes::REGULAR) {
+        if(departureStationID == departureStationIDs.at(row) && pickupTypes.at(row) != REGULAR) {
             reachable = false;
         }
 
         // You must be able to get off a train at your arrival station. The train must drop off passengers there. If not, discard fragment
-        if(this->journey()->arrivalStationURI() == fragment->arrivalStationURI() && fragment->dropOffType() != QRail::Fragments::Fragment::GTFSTypes::REGULAR) {
+        if(arrivalStationID == arrivalStationIDs.at(row) && dropOffTypes.at(row) != REGULAR) {
+            reachable = false;
+        }
+
+        // Even the fastest train can't reach the destination in time from the arrival station of this connection
+        if(lowerBounds && arrivalTimes.at(row) + lowerBounds->at(arrivalStationIDs.at(row)) > journeyArrivalTime) {
             reachable = false;
         }
 
         /*
          * Connection is available (GTFSTypes::REGULAR), we should check if it's a reachable connection using Earliest Arrival CSA.
          */
-        if(reachable && (this->journey()->T_EarliestArrivalTime().contains(fragment->tripURI())
-                         || (this->journey()->S_EarliestArrivalTime().contains(fragment->arrivalStationURI())
-                             && this->journey()->S_EarliestArrivalTime().value(fragment->arrivalStationURI()) >= fragment->arrivalTime())))
+        if(reachable && (journey->T_EarliestArrivalTimeAt(tripIDs.at(row)) > 0
+                         || (journey->S_EarliestArrivalTimeAt(arrivalStationIDs.at(row)) > 0
+                             && journey->S_EarliestArrivalTimeAt(arrivalStationIDs.at(row)) >= arrivalTimes.at(row))))
         {
-            qint16 count = this->journey()->T_EarliestArrivalTime().value(fragment->tripURI(), 0) + 1;
-            QMap<QUrl, qint16> T_early = this->journey()->T_EarliestArrivalTime();
-            T_early.insert(fragment->tripURI(), count);
-            this->journey()->setT_EarliestArrivalTime(T_early);
+            qint16 count = journey->T_EarliestArrivalTimeAt(tripIDs.at(row)) + 1;
+            journey->setT_EarliestArrivalTimeAt(tripIDs.at(row), count);
 #ifdef VERBOSE_PARAMETERS
-            qDebug() << "Connection is reachable:" << fragment->tripURI();
+            qDebug() << "Connection is reachable:" << table->fragment(row)->tripURI();
 #endif
             reachable = true;
+            rows.append(row);
             continue;
         }
         else {
@@ -263,42 +702,40 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
         }
 
         /*
-         * We update the timestamp in the this->journey()->S_EarliestArrivalTime map for the departure station of the connection if:
+         * We update the timestamp in the journey->S_EarliestArrivalTime map for the departure station of the connection if:
          *     - The station URI doesn't exist yet.
          *     - The timestamp for the station URI is higher than our connection's departure time.
          */
-        if(!this->journey()->S_EarliestArrivalTime().contains(fragment->departureStationURI())
-                || this->journey()->S_EarliestArrivalTime().value(fragment->departureStationURI()) > fragment->departureTime())
+        if(journey->S_EarliestArrivalTimeAt(departureStationIDs.at(row)) == 0
+                || journey->S_EarliestArrivalTimeAt(departureStationIDs.at(row)) > departureTimes.at(row))
         {
-            QMap<QUrl, QDateTime> S_early = this->journey()->S_EarliestArrivalTime();
-            S_early.insert(fragment->departureStationURI(), fragment->departureTime());
-            this->journey()->setS_EarliestArrivalTime(S_early);
+            journey->setS_EarliestArrivalTimeAt(departureStationIDs.at(row), departureTimes.at(row));
         }
 
         /*
          * It's useless to process unreachable connections in the Profile Connection Scan Algorithm.
-         * We remove the unreachable connections from the page before the Profile CSA is applied.
+         * Unreachable connections are left out of the rows list before the Profile CSA is applied.
          */
-        if(!reachable) {
 #ifdef VERBOSE_PARAMETERS
-            qDebug() << "Connection is NOT reachable:" << fragment->tripURI();
+        qDebug() << "Connection is NOT reachable:" << table->fragment(row)->tripURI();
 #endif
-            frags.removeOne(fragment);
-        }
     }
 
+    qint32 prunedConnections = table->size() - rows.size();
 #ifdef VERBOSE_PARAMETERS
-    qDebug() << "AFTER number of connections:" << page->fragments().size();
+    qDebug() << "AFTER number of connections:" << rows.size() << "pruned:" << prunedConnections;
 #endif
+    emit this->pruned(page->uri(), prunedConnections);
 
     // Run the CSA Profile Scan Algorithm on the given page, looping in DESCENDING
     // departure times order
-    for (qint16 fragIndex = frags.size() - 1; fragIndex >= 0; --fragIndex) {
-        QSharedPointer<QRail::Fragments::Fragment> fragment = frags.at(fragIndex);
+    for (qint32 rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+        qint32 row = rows.at(rowIndex);
+        QSharedPointer<QRail::Fragments::Fragment> fragment = table->fragment(row);
         qDebug() << "Processing frag:" << fragment->uri();
 
         // We can only process fragments which are departing after our departure time
-        if (fragment->departureTime() <= this->journey()->departureTime()) {
+        if (departureTimes.at(row) <= journeyDepartureTime) {
             hasPassedDepartureTimeLimit = true;
             continue;
         }
@@ -311,12 +748,13 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
 
         // Init variables for the algorithm, see the paper for the explanation
         // behind T1, T2, T3 and Tmin (Tmin = Tc in the paper).
-        QDateTime T1_walkingArrivalTime, T2_stayOnTripArrivalTime, T3_transferArrivalTime, Tmin_earliestArrivalTime;
+        // All times are in seconds since the UNIX epoch, INFINITE_TIME marks an unreachable arrival.
+        qint64 T1_walkingArrivalTime, T2_stayOnTripArrivalTime, T3_transferArrivalTime, Tmin_earliestArrivalTime;
         qint16 T1_transfers, T2_transfers, T3_transfers, Tmin_transfers;
         QSharedPointer<QRail::Fragments::Fragment> newExitTrainFragment; // Save the connection when we exit the train for a transfer
 
         // Calculate T1, the time when walking from the current stop to the destination
-        if (fragment->arrivalStationURI() == this->journey()->arrivalStationURI()) {
+        if (arrivalStationIDs.at(row) == arrivalStationID) {
             /*
              * This connection ends at our destination.
              * We can walk now out of the station towards our destination.
@@ -327,7 +765,7 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
              * them by a given WALKING_SPEED before adding them to the
              * T1_walkingArrivalTime!
              */
-            T1_walkingArrivalTime = fragment->arrivalTime();
+            T1_walkingArrivalTime = arrivalTimes.at(row);
             qDebug() << T1_walkingArrivalTime << "SELECTED";
             T1_transfers = 0; // Walking, no transfers between arrival and destination.
         } else {
@@ -343,17 +781,17 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
 
         // Calculate T2, the earliest time to arrive at our destination when we
         // remain seated on the train.
-        if (this->journey()->TArray().contains(fragment->tripURI())) {
+        if (journey->TArrayAt(tripIDs.at(row))) {
             /*
             * If you stay on the train you will arrive as soon as the train arrives
             * at the destination. The number of transfers stays the same (between
             * this connection and the destination) as we remain seated.
             */
             qDebug() << "Trying to fetch fragment here";
-            qDebug() << this->journey()->TArray().value(fragment->tripURI())->arrivalConnection();
-            T2_stayOnTripArrivalTime = this->journey()->TArray().value(fragment->tripURI())->arrivalTime();
-            T2_transfers = this->journey()->TArray().value(fragment->tripURI())->transfers();
-            qDebug() << "T2 selected this->journey()->TArray().contains(fragment->tripURI())";
+            qDebug() << journey->TArrayAt(tripIDs.at(row))->arrivalConnection();
+            T2_stayOnTripArrivalTime = journey->TArrayAt(tripIDs.at(row))->arrivalTime();
+            T2_transfers = journey->TArrayAt(tripIDs.at(row))->transfers();
+            qDebug() << "T2 selected journey->TArrayAt(tripIDs.at(row))";
         } else {
             /*
             * If the key doesn't exist then we don't have the fastest arrival time to
@@ -371,48 +809,28 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
 
         // Calculate T3, the time of arrival when taking the best possible transfer in this station.
         // We can only get of the train if the train drops off passengers at this station.
-        if (this->journey()->SArray().contains(fragment->arrivalStationURI()) && fragment->dropOffType() == QRail::Fragments::Fragment::GTFSTypes::REGULAR) {
+        if (!journey->SArrayAt(arrivalStationIDs.at(row)).isEmpty() && dropOffTypes.at(row) == REGULAR) {
             /*
             * If there are connections departing from this station,
             * get the one which departs after we arrive, but arrive as soon as
-            * possible. The earliest departure is in the back of the array, keep
-            * track of it using the position integer. As long as we're arriving AFTER
-            * the pair departure or have too much transfers to reach our destination,
-            * move forward in the list until we find a departure which is reachable.
-            * We move from the back to the front since the list is sorted by
-            * DESCENDING departure time, the earliest departure times are in the
-            * back.
+            * possible. The list is sorted by DESCENDING departure time and,
+            * since dominated profiles are never inserted, also by DESCENDING arrival time.
+            * A binary search gives us the earliest departure we can still catch, which is
+            * also the earliest arrival. The transfer index of the Journey skips the profiles
+            * which have too much transfers to reach our destination without walking the list.
             *
             * INTRA_STOP_FOOTPATH_TIME: Time needed for the passenger to switch
             * between vehicles
+            *
+            * Profiles which don't pick up passengers are never stored in the S array,
+            * we can transfer to every profile in the list.
             */
-            qint16 position = this->journey()->SArray().value(fragment->arrivalStationURI()).size() - 1;
-
-            QSharedPointer<QRail::RouterEngine::StationStopProfile> stopProfile = this->journey()->SArray().value(fragment->arrivalStationURI()).at(position);
-
-            // Search for the best possible transfer in this station
-            // We can only transfer to a new train if that train stops at the station and picks up passengers here.
-            while ((((stopProfile->departureTime().toMSecsSinceEpoch() - INTRA_STOP_FOOTPATH_TIME *
-                      MILISECONDS_TO_SECONDS_MULTIPLIER) < fragment->arrivalTime().toMSecsSinceEpoch()) ||
-                    stopProfile->transfers() >= this->journey()->maxTransfers()) && position > 0)
-            {
-                position--;
-                QSharedPointer<QRail::RouterEngine::StationStopProfile> possibleNewStopProfile = this->journey()->SArray().value(fragment->arrivalStationURI()).at(position);
-                if(possibleNewStopProfile->departureConnection()->pickupType() == QRail::Fragments::Fragment::GTFSTypes::REGULAR) {
-                    stopProfile = possibleNewStopProfile;
-                }
-            }
+            const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &stopProfiles = journey->SArrayAt(arrivalStationIDs.at(row));
+            qint32 position = journey->lastTransferableSArrayIndex(arrivalStationIDs.at(row), arrivalTimes.at(row) + INTRA_STOP_FOOTPATH_TIME);
 
             qDebug() << "T3 selected";
-            bool valid = true;
-            if(stopProfile->departureConnection()->pickupType() != QRail::Fragments::Fragment::GTFSTypes::REGULAR) {
-                valid = false;
-                qDebug() << "Initial stop profile is invalid, the chosen profile doesn't have a pick up type == REGULAR";
-            }
-
-            if (((stopProfile->departureTime().toMSecsSinceEpoch() - INTRA_STOP_FOOTPATH_TIME *
-                  MILISECONDS_TO_SECONDS_MULTIPLIER) >= fragment->arrivalTime().toMSecsSinceEpoch()) &&
-                    (stopProfile->transfers() <= this->journey()->maxTransfers()) && valid) {
+            if (position >= 0) {
+                QSharedPointer<QRail::RouterEngine::StationStopProfile> stopProfile = stopProfiles.at(position);
                 /*
                 * If a result appears in this list then we know the earliest arrival
                 * time when transferring here. We prefer to remain seated on a train
@@ -427,7 +845,7 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                 * the journey extraction, we only get a route with less legs
                 * when arrival times are identical.
                 */
-                T3_transferArrivalTime = stopProfile->arrivalTime().addSecs(TRANSFER_EQUIVALENT_TRAVEL_TIME);
+                T3_transferArrivalTime = stopProfile->arrivalTime() + TRANSFER_EQUIVALENT_TRAVEL_TIME;
                 T3_transfers = stopProfile->transfers() + 1; // We transfer here, increment the number of transfers
                 qDebug() << "T3" << T3_transferArrivalTime;
             } else {
@@ -486,7 +904,7 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
             */
             Tmin_earliestArrivalTime = T2_stayOnTripArrivalTime;
             if (T2_stayOnTripArrivalTime < INFINITE_TIME) {
-                newExitTrainFragment = this->journey()->TArray().value(fragment->tripURI())->arrivalConnection();
+                newExitTrainFragment = journey->TArrayAt(tripIDs.at(row))->arrivalConnection();
             } else {
                 qDebug() << "NULLPTR exitrain";
                 newExitTrainFragment = nullptr;
@@ -543,14 +961,14 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
         * times). This only modifies the transfer stop and nothing else in the
         * journey.
         */
-        if (this->journey()->TArray().contains(fragment->tripURI())) {
-            if ((Tmin_earliestArrivalTime == this->journey()->TArray().value(fragment->tripURI())->arrivalTime()) &&
-                    (this->journey()->TArray().value(fragment->tripURI())->arrivalConnection()->arrivalStationURI() !=
-                     this->journey()->arrivalStationURI()) &&
+        if (journey->TArrayAt(tripIDs.at(row))) {
+            if ((Tmin_earliestArrivalTime == journey->TArrayAt(tripIDs.at(row))->arrivalTime()) &&
+                    (journey->TArrayAt(tripIDs.at(row))->arrivalConnection()->arrivalStationID() !=
+                     arrivalStationID) &&
                     T3_transferArrivalTime == T2_stayOnTripArrivalTime &&
-                    this->journey()->SArray().contains(this->journey()->TArray().value(
-                                                           fragment->tripURI())->arrivalConnection()->arrivalStationURI()) &&
-                    this->journey()->SArray().contains(fragment->arrivalStationURI())) {
+                    !journey->SArrayAt(journey->TArrayAt(
+                                                      tripIDs.at(row))->arrivalConnection()->arrivalStationID()).isEmpty() &&
+                    !journey->SArrayAt(arrivalStationIDs.at(row)).isEmpty()) {
                 qDebug() << "2nd IF";
                 /*
                 * When the arrival time is the same, the number of transfer should also
@@ -559,7 +977,7 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                 * connection (fragment), does this improve the transfer time?
                 */
                 QSharedPointer<QRail::Fragments::Fragment> currentExitTrainFragment =
-                        this->journey()->TArray().value(fragment->tripURI())->arrivalConnection();
+                        journey->TArrayAt(tripIDs.at(row))->arrivalConnection();
 
                 /*
                 * Now we need the departure in the next station.
@@ -574,40 +992,39 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                 */
 
                 // Current situation
-                QSharedPointer<QRail::RouterEngine::StationStopProfile> currentStationStopProfile (new QRail::RouterEngine::StationStopProfile(
-                                                                                                       fragment->departureTime(),
-                                                                                                       Tmin_earliestArrivalTime,
-                                                                                                       fragment,
-                                                                                                       currentExitTrainFragment,
-                                                                                                       Tmin_transfers
-                                                                                                       ));
-                QSharedPointer<QRail::RouterEngine::StationStopProfile> currentFirstReachableProfile = this->getFirstReachableConnection(currentStationStopProfile);
+                QSharedPointer<QRail::RouterEngine::StationStopProfile> currentStationStopProfile = QSharedPointer<QRail::RouterEngine::StationStopProfile>::create(
+                        departureTimes.at(row),
+                        Tmin_earliestArrivalTime,
+                        fragment,
+                        currentExitTrainFragment,
+                        Tmin_transfers);
+                QSharedPointer<QRail::RouterEngine::StationStopProfile> currentFirstReachableProfile = this->getFirstReachableConnection(journey, currentStationStopProfile);
                 qint64 currentTransferDuration = -1;
 
                 // Only when we found a reachable connection
                 qDebug() << "Getting first reachable profile";
                 if (currentFirstReachableProfile) {
-                    currentTransferDuration = currentExitTrainFragment->arrivalTime().secsTo(currentFirstReachableProfile->departureTime());
+                    currentTransferDuration = currentFirstReachableProfile->departureTime()
+                            - currentExitTrainFragment->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
                 } else {
                     qCritical() << "Unable to get first reachable connection!";
                     emit this->error("Unable to retrieve the first reachable connection!");
                 }
 
                 // New situation
-                QSharedPointer<QRail::RouterEngine::StationStopProfile> newStationStopProfile (new QRail::RouterEngine::StationStopProfile(
-                                                                                                   fragment->departureTime(),
-                                                                                                   Tmin_earliestArrivalTime,
-                                                                                                   fragment,
-                                                                                                   newExitTrainFragment,
-                                                                                                   Tmin_transfers
-                                                                                                   ));
-                QSharedPointer<QRail::RouterEngine::StationStopProfile> newFirstReachableProfile = this->getFirstReachableConnection(newStationStopProfile);
+                QSharedPointer<QRail::RouterEngine::StationStopProfile> newStationStopProfile = QSharedPointer<QRail::RouterEngine::StationStopProfile>::create(
+                        departureTimes.at(row),
+                        Tmin_earliestArrivalTime,
+                        fragment,
+                        newExitTrainFragment,
+                        Tmin_transfers);
+                QSharedPointer<QRail::RouterEngine::StationStopProfile> newFirstReachableProfile = this->getFirstReachableConnection(journey, newStationStopProfile);
                 qint64 newTransferDuration = -1;
 
                 // Only when we found a reachable connection
                 if (newFirstReachableProfile) {
-                    newTransferDuration = newExitTrainFragment->arrivalTime().secsTo(
-                                newFirstReachableProfile->departureTime());
+                    newTransferDuration = newFirstReachableProfile->departureTime()
+                            - newExitTrainFragment->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
                 } else {
                     qCritical() << "Unable to get first reachable connection!";
                     emit this->error("Unable to retrieve the first reachable connection!");
@@ -616,14 +1033,11 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                 // Comparing: is the new situation better?
                 if (currentTransferDuration > 0 && newTransferDuration > 0
                         && newTransferDuration > currentTransferDuration) {
-                    QSharedPointer<QRail::RouterEngine::TrainProfile> newTrainProfile (new QRail::RouterEngine::TrainProfile(
-                                                                                           Tmin_earliestArrivalTime,
-                                                                                           newExitTrainFragment,
-                                                                                           Tmin_transfers
-                                                                                           ));
-                    QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > T = this->journey()->TArray();
-                    T.insert(fragment->tripURI(), newTrainProfile);
-                    this->journey()->setTArray(T);
+                    QSharedPointer<QRail::RouterEngine::TrainProfile> newTrainProfile = QSharedPointer<QRail::RouterEngine::TrainProfile>::create(
+                            Tmin_earliestArrivalTime,
+                            newExitTrainFragment,
+                            Tmin_transfers);
+                    journey->setTArrayAt(tripIDs.at(row), newTrainProfile);
                 }
             }
             else {
@@ -631,37 +1045,33 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
             }
 
             // We found a faster way, update the T array
-            if (Tmin_earliestArrivalTime < this->journey()->TArray().value(fragment->tripURI())->arrivalTime()) {
+            if (Tmin_earliestArrivalTime < journey->TArrayAt(tripIDs.at(row))->arrivalTime()) {
                 qDebug() << "Faster way, updating T array";
-                QSharedPointer<QRail::RouterEngine::TrainProfile> fasterTrainProfile (new QRail::RouterEngine::TrainProfile(
-                                                                                          Tmin_earliestArrivalTime,
-                                                                                          newExitTrainFragment,
-                                                                                          Tmin_transfers
-                                                                                          ));
-                QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > T = this->journey()->TArray();
-                T.insert(fragment->tripURI(), fasterTrainProfile);
-                this->journey()->setTArray(T);
+                QSharedPointer<QRail::RouterEngine::TrainProfile> fasterTrainProfile = QSharedPointer<QRail::RouterEngine::TrainProfile>::create(
+                        Tmin_earliestArrivalTime,
+                        newExitTrainFragment,
+                        Tmin_transfers);
+                journey->setTArrayAt(tripIDs.at(row), fasterTrainProfile);
             }
         }
         // Not existing, no replacement, only insertion (no memory leaks)
         else {
             qDebug() << "Non existing, inserting into T array";
-            QSharedPointer<QRail::RouterEngine::TrainProfile> nonExistingTrainProfile(new QRail::RouterEngine::TrainProfile(
-                                                                                          Tmin_earliestArrivalTime,
-                                                                                          newExitTrainFragment,
-                                                                                          Tmin_transfers
-                                                                                          ));
-            QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > T = this->journey()->TArray();
-            T.insert(fragment->tripURI(), nonExistingTrainProfile);
-            this->journey()->setTArray(T);
+            QSharedPointer<QRail::RouterEngine::TrainProfile> nonExistingTrainProfile = QSharedPointer<QRail::RouterEngine::TrainProfile>::create(
+                    Tmin_earliestArrivalTime,
+                    newExitTrainFragment,
+                    Tmin_transfers);
+            journey->setTArrayAt(tripIDs.at(row), nonExistingTrainProfile);
         }
 
         qDebug() << "T-ARRAY updated";
 #ifdef VERBOSE_T_ARRAY
         qDebug() << "T-ARRAY";
-        foreach (QUrl k, this->journey()->TArray().keys()) {
-            qDebug() << k.toString() << ":"
-                     << this->journey()->TArray().value(k)->arrivalTime().toString("hh:mm");
+        for (qint32 k = 0; k < journey->TArray().size(); k++) {
+            if (journey->TArrayAt(k)) {
+                qDebug() << QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP)->uri(k).toString() << ":"
+                         << QDateTime::fromMSecsSinceEpoch(journey->TArrayAt(k)->arrivalTime() * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC).toString("hh:mm");
+            }
         }
 #endif
 
@@ -674,78 +1084,64 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
         * StationStopProfile. This is automatically the case since the new
         * departure time is always less or equal than the ones already stored in
         * the S array (departures are sorted by DESCENDING departure times).
+        *
+        * Passengers can't board this connection if it doesn't pick up passengers
+        * in the departure station, such profiles are useless for transfers and results.
         */
+        if (pickupTypes.at(row) != REGULAR) {
+            qDebug() << "Connection doesn't pick up passengers, S array not updated";
+            continue;
+        }
 
-        QSharedPointer<QRail::RouterEngine::StationStopProfile> updatedStationStopProfile(new QRail::RouterEngine::StationStopProfile(
-                                                                                              fragment->departureTime(),
-                                                                                              Tmin_earliestArrivalTime,
-                                                                                              fragment,
-                                                                                              this->journey()->TArray().value(fragment->tripURI())->arrivalConnection(),
-                                                                                              Tmin_transfers
-                                                                                              ));
+        // Dominated profiles are never stored in the S array, don't allocate them either
+        if (!journey->SArrayAt(departureStationIDs.at(row)).isEmpty()
+                && Tmin_earliestArrivalTime >= journey->SArrayAt(departureStationIDs.at(row)).last()->arrivalTime()) {
+            continue;
+        }
+
+        QSharedPointer<QRail::RouterEngine::StationStopProfile> updatedStationStopProfile = QSharedPointer<QRail::RouterEngine::StationStopProfile>::create(
+                departureTimes.at(row),
+                Tmin_earliestArrivalTime,
+                fragment,
+                journey->TArrayAt(tripIDs.at(row))->arrivalConnection(),
+                Tmin_transfers);
 
         // Entry already exists in the S array
-        if (this->journey()->SArray().contains(fragment->departureStationURI())) {
-            qint16 numberOfPairs = this->journey()->SArray().value(fragment->departureStationURI()).size();
-            QSharedPointer<QRail::RouterEngine::StationStopProfile> existingStationStopProfile = this->journey()->SArray().value(fragment->departureStationURI()).at(numberOfPairs - 1);
+        if (!journey->SArrayAt(departureStationIDs.at(row)).isEmpty()) {
+            qint16 numberOfPairs = journey->SArrayAt(departureStationIDs.at(row)).size();
+            QSharedPointer<QRail::RouterEngine::StationStopProfile> existingStationStopProfile = journey->SArrayAt(departureStationIDs.at(row)).at(numberOfPairs - 1);
             if (updatedStationStopProfile->arrivalTime() < existingStationStopProfile->arrivalTime()) {
                 // Replace existing StationStopProfile at the back when departure times are equal
                 if (updatedStationStopProfile->departureTime() == existingStationStopProfile->departureTime()) {
-                    /*
-                    * COMPILER ERROR:
-                    * Modifying the return value of S.value(URI) isn't allowed.
-                    * The return value is declared by Qt as a constant,
-                    * modifying it directly violates this restriction. Copying this QList
-                    * into a variable, modifying it and then replace it in the S array
-                    * circumvents this issue.
-                    *
-                    * OUTPUT:
-                    * error: passing 'const QList<StationStopProfile*>' as 'this'
-                    * argument of 'void QList<T>::replace(int, const T&) [with T
-                    * = StationStopProfile*]' discards qualifiers [-fpermissive]
-                    * S.value(fragment-> departureStationURI()).replace(numberOfPairs -
-                    * 1, updatedStationStopProfile); ^
-                    */
-
-                    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > S = this->journey()->SArray();
-                    QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > SProfiles = S.value(fragment->departureStationURI());
                     // Replace profile when departure times are equal
-                    SProfiles.replace(numberOfPairs - 1, updatedStationStopProfile);
-                    S.insert(fragment->departureStationURI(), SProfiles);
-                    this->journey()->setSArray(S);
+                    journey->replaceLastSArrayAt(departureStationIDs.at(row), updatedStationStopProfile);
                 }
                 // We're iterating over DESCENDING departure times, inserting the
                 // StationStopProfile at the back
                 else {
-                    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > S = this->journey()->SArray();
-                    QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > SProfiles = S.value(fragment->departureStationURI());
                     // Add profile when we have different departure times
-                    SProfiles.append(updatedStationStopProfile);
-                    S.insert(fragment->departureStationURI(), SProfiles);
-                    this->journey()->setSArray(S);
+                    journey->appendSArrayAt(departureStationIDs.at(row), updatedStationStopProfile);
                 }
             }
         }
         // New entry in the S array
         else {
-            QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > S = this->journey()->SArray();
-            QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > stationStopProfileList = QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> >();
-
             // Add new entry if it doesn't exist yet
-            stationStopProfileList.append(updatedStationStopProfile);
-            S.insert(fragment->departureStationURI(), stationStopProfileList);
-            this->journey()->setSArray(S);
+            journey->appendSArrayAt(departureStationIDs.at(row), updatedStationStopProfile);
         }
 
 #ifdef VERBOSE_S_ARRAY
         qDebug() << "S-ARRAY";
-        foreach (QUrl k, this->journey()->SArray().keys()) {
-            qDebug() << k.toString();
+        for (qint32 k = 0; k < journey->SArray().size(); k++) {
+            if (journey->SArrayAt(k).isEmpty()) {
+                continue;
+            }
+            qDebug() << QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->uri(k).toString();
             foreach (QSharedPointer<QRail::RouterEngine::StationStopProfile> p,
-                     this->journey()->SArray().value(k)) {
+                     journey->SArrayAt(k)) {
                 qDebug() << "\t" << p->departureConnection()->tripURI().toString()
-                         << ":" << p->arrivalTime().toString("hh:mm") << "|"
-                         << p->departureTime().toString("hh:mm");
+                         << ":" << QDateTime::fromMSecsSinceEpoch(p->arrivalTime() * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC).toString("hh:mm") << "|"
+                         << QDateTime::fromMSecsSinceEpoch(p->departureTime() * MILISECONDS_TO_SECONDS_MULTIPLIER, Qt::UTC).toString("hh:mm");
             }
         }
 #endif
@@ -764,12 +1160,33 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
     */
 
     // Results found, process them
-    if (this->journey()->SArray().contains(this->journey()->departureStationURI())) {
-        qDebug() << "Processing results: " << this->journey()->SArray().value(this->journey()->departureStationURI());
-        foreach (QSharedPointer<QRail::RouterEngine::StationStopProfile> profile, this->journey()->SArray().value(this->journey()->departureStationURI())) {
-            QList<QSharedPointer<QRail::RouterEngine::RouteLeg>> legs = QList<QSharedPointer<QRail::RouterEngine::RouteLeg>>();
+    this->extractRoutes(journey, departureStationID, arrivalStationID);
 
-            while (profile->arrivalConnection()->arrivalStationURI() != this->journey()->arrivalStationURI()) {
+    return true;
+}
+
+void QRail::RouterEngine::Planner::extractRoutes(QRail::RouterEngine::Journey *journey,
+                                                 const quint32 departureStationID,
+                                                 const quint32 arrivalStationID)
+{
+    const qint64 journeyDepartureTime = journey->departureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    const qint64 journeyLatestDepartureTime = journey->latestDepartureTime().isValid()? journey->latestDepartureTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER: 0;
+    if (!journey->SArrayAt(departureStationID).isEmpty()) {
+        qDebug() << "Processing results: " << journey->SArrayAt(departureStationID);
+        foreach (QSharedPointer<QRail::RouterEngine::StationStopProfile> profile, journey->SArrayAt(departureStationID)) {
+            // Profiles restored from the destination cache can depart before the requested departure time
+            if (profile->departureTime() <= journeyDepartureTime) {
+                continue;
+            }
+
+            // Range queries only return the routes departing in their departure time window, the latest departure time is inclusive
+            if (journeyLatestDepartureTime > 0 && profile->departureTime() > journeyLatestDepartureTime) {
+                continue;
+            }
+
+            // Follow the profiles to the destination, each hop is a leg of the route
+            QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > hops;
+            while (profile->arrivalConnection()->arrivalStationID() != arrivalStationID) {
 #ifdef VERBOSE_LEGS
                 qDebug() << "Extracted profile:";
                 qDebug() << profile->departureConnection()
@@ -781,45 +1198,10 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                         << profile->arrivalConnection()->arrivalStationURI().toString()
                         << profile->arrivalConnection()->arrivalTime().toString("hh:mm");
 #endif
-                QSharedPointer<QRail::RouterEngine::RouteLegEnd> departureLeg =
-                        QSharedPointer<QRail::RouterEngine::RouteLegEnd>(new QRail::RouterEngine::RouteLegEnd(
-                                                                             profile->departureConnection()->uri(),
-                                                                             profile->departureConnection()->departureTime(),
-                                                                             this->stationFactory()->getStationByURI(profile->departureConnection()->departureStationURI()),
-                                                                             QString("?"),
-                                                                             true,
-                                                                             profile->departureConnection()->departureDelay(),
-                                                                             false,
-                                                                             profile->departureConnection()->departureTime() < QDateTime::currentDateTimeUtc(),
-                                                                             QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
-
-                QSharedPointer<QRail::RouterEngine::RouteLegEnd> arrivalLeg =
-                        QSharedPointer<QRail::RouterEngine::RouteLegEnd>(new QRail::RouterEngine::RouteLegEnd(
-                                                                             profile->arrivalConnection()->uri(),
-                                                                             profile->arrivalConnection()->arrivalTime(),
-                                                                             this->stationFactory()->getStationByURI(profile->arrivalConnection()->arrivalStationURI()),
-                                                                             QString("?"),
-                                                                             true,
-                                                                             profile->arrivalConnection()->departureDelay(),
-                                                                             false,
-                                                                             profile->arrivalConnection()->arrivalTime() < QDateTime::currentDateTimeUtc(),
-                                                                             QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
-
-                // Create vehicle information
-                QSharedPointer<QRail::VehicleEngine::Vehicle> vehicle =
-                        QSharedPointer<QRail::VehicleEngine::Vehicle>(new QRail::VehicleEngine::Vehicle(
-                                                                          profile->departureConnection()->routeURI(),
-                                                                          profile->departureConnection()->tripURI(),
-                                                                          profile->departureConnection()->direction()));
-
-                QSharedPointer<QRail::RouterEngine::RouteLeg> routeLeg =
-                        QSharedPointer<QRail::RouterEngine::RouteLeg>(new QRail::RouterEngine::RouteLeg(
-                                                                          QRail::RouterEngine::RouteLeg::Type::TRAIN, vehicle,
-                                                                          departureLeg, arrivalLeg));
-                legs.append(routeLeg);
+                hops.append(profile);
 
                 // Search for the next reachable hop
-                profile = this->getFirstReachableConnection(profile);
+                profile = this->getFirstReachableConnection(journey, profile);
             }
 
 #ifdef VERBOSE_LEGS
@@ -830,68 +1212,31 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
                      << profile->arrivalConnection()->arrivalTime().toString("hh:mm");
 #endif
             // We need to add the arrival leg too!
-            QSharedPointer<QRail::RouterEngine::RouteLegEnd> departureLeg =
-                    QSharedPointer<QRail::RouterEngine::RouteLegEnd>(new QRail::RouterEngine::RouteLegEnd(
-                                                                         profile->departureConnection()->uri(),
-                                                                         profile->departureConnection()->departureTime(),
-                                                                         this->stationFactory()->getStationByURI(profile->departureConnection()->departureStationURI()),
-                                                                         QString("?"),
-                                                                         true,
-                                                                         profile->departureConnection()->departureDelay(),
-                                                                         false,
-                                                                         profile->departureConnection()->departureTime() < QDateTime::currentDateTimeUtc(),
-                                                                         QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
-
-            QSharedPointer<QRail::RouterEngine::RouteLegEnd> arrivalLeg =
-                    QSharedPointer<QRail::RouterEngine::RouteLegEnd>(new QRail::RouterEngine::RouteLegEnd(
-                                                                         profile->arrivalConnection()->uri(),
-                                                                         profile->arrivalConnection()->arrivalTime(),
-                                                                         this->stationFactory()->getStationByURI(profile->arrivalConnection()->arrivalStationURI()),
-                                                                         QString("?"),
-                                                                         true,
-                                                                         profile->arrivalConnection()->departureDelay(),
-                                                                         false,
-                                                                         profile->arrivalConnection()->arrivalTime() < QDateTime::currentDateTimeUtc(),
-                                                                         QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED
-                                                                         ));
-
-            // Create vehicle information
-            QSharedPointer<QRail::VehicleEngine::Vehicle> vehicle =
-                    QSharedPointer<QRail::VehicleEngine::Vehicle>(new QRail::VehicleEngine::Vehicle(
-                                                                      profile->departureConnection()->routeURI(),
-                                                                      profile->departureConnection()->tripURI(),
-                                                                      profile->departureConnection()->direction()
-                                                                      ));
-
-            // Create route
-            QSharedPointer<QRail::RouterEngine::RouteLeg> routeLeg =
-                    QSharedPointer<QRail::RouterEngine::RouteLeg>(new QRail::RouterEngine::RouteLeg(
-                                                                      QRail::RouterEngine::RouteLeg::Type::TRAIN,
-                                                                      vehicle,
-                                                                      departureLeg,
-                                                                      arrivalLeg
-                                                                      ));
-            legs.append(routeLeg);
-
-            QSharedPointer<QRail::RouterEngine::Route> route(new QRail::RouterEngine::Route(legs));
-
-            // Avoid duplicates
+            hops.append(profile);
+
+            // Avoid duplicates, routes are extracted after every page so most of them are known already
             bool newRoute = true;
-            foreach (QSharedPointer<QRail::RouterEngine::Route> r, this->journey()->routes()) {
+            foreach (QSharedPointer<QRail::RouterEngine::Route> r, journey->routes()) {
                 // Routes with the same arrival and departure times are duplicates
-                if (route->departureTime() == r->departureTime()
-                        && route->arrivalTime() == r->arrivalTime()) {
+                if (hops.first()->departureConnection()->departureTime() == r->departureTime()
+                        && hops.last()->arrivalConnection()->arrivalTime() == r->arrivalTime()) {
                     qDebug() << "Duplicate found, skipping";
                     newRoute = false;
                     break;
                 }
             }
 
+            // Only build the legs of new routes
             if (newRoute) {
+                QList<QSharedPointer<QRail::RouterEngine::RouteLeg>> legs = QList<QSharedPointer<QRail::RouterEngine::RouteLeg>>();
+                foreach (QSharedPointer<QRail::RouterEngine::StationStopProfile> hop, hops) {
+                    legs.append(this->createRouteLeg(hop));
+                }
+                QSharedPointer<QRail::RouterEngine::Route> route = QSharedPointer<QRail::RouterEngine::Route>::create(legs);
                 emit this->stream(route);
-                QList<QSharedPointer<QRail::RouterEngine::Route> > routeList = this->journey()->routes();
+                QList<QSharedPointer<QRail::RouterEngine::Route> > routeList = journey->routes();
                 routeList.append(route);
-                this->journey()->setRoutes(routeList);
+                journey->setRoutes(routeList);
             }
         }
 
@@ -903,56 +1248,55 @@ void QRail::RouterEngine::Planner::parsePage(QSharedPointer<QRail::Fragments::Pa
         *
         * REMARK: C++11 support needed for lambda expressions
         */
-        QList<QSharedPointer<QRail::RouterEngine::Route > > routeList = this->journey()->routes();
+        QList<QSharedPointer<QRail::RouterEngine::Route > > routeList = journey->routes();
         std::sort(routeList.begin(), routeList.end(), [](const QSharedPointer<QRail::RouterEngine::Route> a,
                   const QSharedPointer<QRail::RouterEngine::Route> b) -> bool {
             QDateTime timeA = a->departureTime();
             QDateTime timeB = b->departureTime();
             return timeA < timeB;
         });
-        this->journey()->setRoutes(routeList);
-    }
-
-
-    // Add the current snapshot to the Journey object for rollback support
-    if(m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
-        QRail::RouterEngine::SnapshotJourney *snapshotJourney = new QRail::RouterEngine::SnapshotJourney(page->uri(),
-                                                                                                         this->journey()->hydraNext(),
-                                                                                                         this->journey()->hydraPrevious(),
-                                                                                                         this->journey()->routes(),
-                                                                                                         this->journey()->T_EarliestArrivalTime(),
-                                                                                                         this->journey()->S_EarliestArrivalTime(),
-                                                                                                         this->journey()->SArray(),
-                                                                                                         this->journey()->TArray());
-        this->journey()->addSnapshotJourney(snapshotJourney);
+        journey->setRoutes(routeList);
     }
+}
 
-
-    /*
-    * ===========================
-    *         CLEANING UP
-    * ===========================
-    * In case we haven't found any results, we load more data or
-    * stop if we passed the departure time limit (see hasPassedDepartureTimeLimit
-    * flag).
-    */
-
-    // No results found, load more data if needed or return empty list
-    if (hasPassedDepartureTimeLimit) {
-        qDebug() << "Departure time limit passed, wrapping up";
-
-        // Emit the error signal when we haven't found any routes
-        if (this->journey()->routes().size() == 0) {
-            emit this->error("No routes found!");
-            emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
-        }
-
-        // Emit finished signal when we completely parsed and processed all Linked Connections pages
-        emit this->finished(this->journey());
-    }
+QSharedPointer<QRail::RouterEngine::RouteLeg> QRail::RouterEngine::Planner::createRouteLeg(QSharedPointer<QRail::RouterEngine::StationStopProfile> profile)
+{
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> departureLeg = QSharedPointer<QRail::RouterEngine::RouteLegEnd>::create(
+                profile->departureConnection()->uri(),
+                profile->departureConnection()->departureTime(),
+                this->stationFactory()->getStationByURI(profile->departureConnection()->departureStationURI()),
+                QString("?"),
+                true,
+                profile->departureConnection()->departureDelay(),
+                false,
+                profile->departureConnection()->departureTime() < QDateTime::currentDateTimeUtc(),
+                QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED);
+
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> arrivalLeg = QSharedPointer<QRail::RouterEngine::RouteLegEnd>::create(
+                profile->arrivalConnection()->uri(),
+                profile->arrivalConnection()->arrivalTime(),
+                this->stationFactory()->getStationByURI(profile->arrivalConnection()->arrivalStationURI()),
+                QString("?"),
+                true,
+                profile->arrivalConnection()->departureDelay(),
+                false,
+                profile->arrivalConnection()->arrivalTime() < QDateTime::currentDateTimeUtc(),
+                QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED);
+
+    // Create vehicle information
+    QSharedPointer<QRail::VehicleEngine::Vehicle> vehicle = QSharedPointer<QRail::VehicleEngine::Vehicle>::create(
+                profile->departureConnection()->routeURI(),
+                profile->departureConnection()->tripURI(),
+                profile->departureConnection()->direction());
+
+    return QSharedPointer<QRail::RouterEngine::RouteLeg>::create(QRail::RouterEngine::RouteLeg::Type::TRAIN,
+                                                                 vehicle,
+                                                                 departureLeg,
+                                                                 arrivalLeg);
 }
 
 QSharedPointer<QRail::RouterEngine::StationStopProfile> QRail::RouterEngine::Planner::getFirstReachableConnection(
+        QRail::RouterEngine::Journey *journey,
         QSharedPointer<QRail::RouterEngine::StationStopProfile> arrivalProfile)
 {
     /*
@@ -964,8 +1308,11 @@ QSharedPointer<QRail::RouterEngine::StationStopProfile> QRail::RouterEngine::Pla
     * between the arrival times. ERROR: When no reachable connections are found
     * we return a nullptr. This circumvents the 'index out of range' error.
     */
-    QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > options = this->journey()->SArray().value(arrivalProfile->arrivalConnection()->arrivalStationURI());
-    qint16 i = options.size() - 1;
+    quint32 stationID = arrivalProfile->arrivalConnection()->arrivalStationID();
+    const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &options = journey->SArrayAt(stationID);
+    if (options.isEmpty()) {
+        return QSharedPointer<QRail::RouterEngine::StationStopProfile>();
+    }
 
 #ifdef VERBOSE_FIRST_REACHABLE_CONNECTION
     qDebug() << "Reachable connections for" <<
@@ -976,20 +1323,30 @@ QSharedPointer<QRail::RouterEngine::StationStopProfile> QRail::RouterEngine::Pla
     }
 #endif
 
-    // Find the first reachable connection
-    while (i > 0
-           && (options.at(i)->arrivalTime().toMSecsSinceEpoch() !=
-               (arrivalProfile->arrivalTime().toMSecsSinceEpoch() - TRANSFER_EQUIVALENT_TRAVEL_TIME *
-                MILISECONDS_TO_SECONDS_MULTIPLIER))) {
-        i--;
-    }
+    // Find the first reachable connection, the profiles are sorted by DESCENDING arrival time
+    qint32 i = journey->indexOfSArrayArrivalTime(stationID, arrivalProfile->arrivalTime() - TRANSFER_EQUIVALENT_TRAVEL_TIME);
 
-    // Return the profile
-    return options.at(i);
+    // Return the profile, fall back on the latest departure if no profile matches
+    return options.at(i >= 0 ? i : 0);
 }
 
-void QRail::RouterEngine::Planner::processPage(QSharedPointer<QRail::Fragments::Page> page)
+void QRail::RouterEngine::Planner::processPage(QSharedPointer<QRail::Fragments::Page> page, QObject *caller, quint64 requestID)
 {
+    // Multiple planners share the Fragments::Factory, only handle our own pages
+    if (caller != this) {
+        return;
+    }
+
+    /*
+    * Pages still in flight after a deadline, timeout or abort aren't needed
+    * anymore. They can even arrive after the next operation started, every
+    * request carries the generation of the operation which made it.
+    */
+    if (!m_isRunning || requestID != m_queryGeneration) {
+        qDebug() << "Ignoring page of a finished operation:" << page->uri();
+        return;
+    }
+
     qDebug() << "Factory generated requested Linked Connection page:"
              << page->uri()
              << "starting processing thread..." << page->fragments().length();
@@ -998,8 +1355,31 @@ void QRail::RouterEngine::Planner::processPage(QSharedPointer<QRail::Fragments::
     // Add page to used pages and restart timeout timer
     progressTimeoutTimer->start();
 
+    // Forward Earliest Arrival search to find the arrival time bound
+    if (m_forwardSearch) {
+        this->processForwardPage(page);
+        return;
+    }
+
+    // Keep the previous pages in flight while this page is scanned
+    if (this->prefetchDepth() > 0 && !this->isAbortRequested()
+            && (this->isBatchRunning() || page->fragments().size() <= 0
+                || page->fragments().first()->departureTime() > this->journey()->departureTime())) {
+        this->prefetchPages(page->hydraPrevious(), QRail::Fragments::Factory::Direction::PREVIOUS);
+    }
+
     // Launch processing of page
     qDebug() << "Start parsing";
+    if (this->isBatchRunning()) {
+        this->parseBatchPage(page);
+
+        // Batch finished or aborted, no new requests should be made
+        if (this->isBatchRunning() && !this->isAbortRequested()) {
+            this->requestPage(page->hydraPrevious());
+            emit this->requested(page->hydraPrevious());
+        }
+        return;
+    }
     this->parsePage(page);
 
     /*
@@ -1020,7 +1400,7 @@ void QRail::RouterEngine::Planner::processPage(QSharedPointer<QRail::Fragments::
 
         // Aborted, no new requests should be made
         if(!this->isAbortRequested()) {
-            this->fragmentsFactory()->getPage(page->hydraPrevious());
+            this->requestPage(page->hydraPrevious());
             emit this->requested(page->hydraPrevious());
         }
     }
@@ -1029,6 +1409,17 @@ void QRail::RouterEngine::Planner::processPage(QSharedPointer<QRail::Fragments::
 //
 void RouterEngine::Planner::reroute()
 {
+    // Nothing to reroute yet
+    if (!this->journey() || !this->isBackgroundUpdatesEnabled()) {
+        return;
+    }
+
+    // A query or reroute is still running, try again on the next tick
+    if (m_isRunning) {
+        qDebug() << "Planner is busy, skipping timed reroute";
+        return;
+    }
+
     emit this->startReroute();
 
     // Reroute using the existing journey
@@ -1064,6 +1455,109 @@ QDateTime QRail::RouterEngine::Planner::calculateArrivalTime(const QDateTime &de
     return arrivalTime;
 }
 
+/*
+ * Lower bounds of the travel time in seconds from every station to the destination.
+ * The straight line distance is travelled at MAXIMUM_TRAIN_SPEED, which no route can beat.
+ * Stations without a known position get a lower bound of 0 and are never pruned.
+ * The bounds are computed once per destination, only new stations are added afterwards.
+ * Station positions are looked up once per station, unknown stations included.
+ */
+const QVector<qint64> &QRail::RouterEngine::Planner::lowerBounds(const quint32 arrivalStationID)
+{
+    QRail::Fragments::URIIndex *stationIndex = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION);
+    QVector<qint64> &bounds = m_lowerBounds[arrivalStationID];
+    qint32 stationCount = static_cast<qint32>(stationIndex->count());
+    if (bounds.size() >= stationCount) {
+        return bounds;
+    }
+
+    QGeoCoordinate destination = this->stationPosition(arrivalStationID);
+    const qreal maximumSpeed = MAXIMUM_TRAIN_SPEED * 1000.0 / SECONDS_TO_HOURS_MULTIPLIER; // m/s
+    qint32 firstNewStation = bounds.size();
+    bounds.resize(stationCount);
+    for (qint32 stationID = firstNewStation; stationID < stationCount; stationID++) {
+        bounds[stationID] = 0;
+        if (!destination.isValid()) {
+            continue;
+        }
+
+        QGeoCoordinate position = this->stationPosition(static_cast<quint32>(stationID));
+        if (position.isValid()) {
+            bounds[stationID] = static_cast<qint64>(position.distanceTo(destination) / maximumSpeed);
+        }
+    }
+    return bounds;
+}
+
+QGeoCoordinate QRail::RouterEngine::Planner::stationPosition(const quint32 stationID)
+{
+    if (m_stationPositions.contains(stationID)) {
+        return m_stationPositions.value(stationID);
+    }
+
+    // Foreign or unknown stations aren't in the database, their position stays invalid
+    QUrl uri = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->uri(stationID);
+    QSharedPointer<StationEngine::Station> station = this->stationFactory()->getStationByURI(uri);
+    QGeoCoordinate position = station? station->position(): QGeoCoordinate();
+    m_stationPositions.insert(stationID, position);
+    return position;
+}
+
+QRail::RouterEngine::Journey *QRail::RouterEngine::Planner::createJourney(const QRail::RouterEngine::Query &query)
+{
+    QRail::RouterEngine::Journey *journey = new QRail::RouterEngine::Journey(this);
+    journey->setTArray(QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> >());
+    journey->setSArray(QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > >());
+    journey->setDepartureStationURI(query.departureStation());
+    journey->setArrivalStationURI(query.arrivalStation());
+    journey->setDepartureTime(query.departureTime());
+    journey->setLatestDepartureTime(query.latestDepartureTime());
+    if (query.latestDepartureTime().isValid()) {
+        journey->setArrivalTime(this->calculateArrivalTime(query.latestDepartureTime()));
+    } else {
+        journey->setArrivalTime(this->calculateArrivalTime(query.departureTime()));
+    }
+    journey->setMaxTransfers(query.maxTransfers());
+    journey->setRoutes(QList<QSharedPointer<QRail::RouterEngine::Route> >());
+    journey->setT_EarliestArrivalTime(QVector<qint16>());
+    quint32 arrivalStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(query.arrivalStation());
+    QVector<qint64> S_early = QVector<qint64>(arrivalStationID + 1);
+    S_early[arrivalStationID] = journey->arrivalTime().toMSecsSinceEpoch() / MILISECONDS_TO_SECONDS_MULTIPLIER;
+    journey->setS_EarliestArrivalTime(S_early);
+    return journey;
+}
+
+QDateTime QRail::RouterEngine::Planner::forwardSearchDepartureTime() const
+{
+    // The arrival time bound must hold for the latest departure of a range query
+    if (this->journey()->latestDepartureTime().isValid()) {
+        return this->journey()->latestDepartureTime();
+    }
+    return this->journey()->departureTime();
+}
+
+void QRail::RouterEngine::Planner::requestPage(const QUrl &uri)
+{
+    // The Fragments::Factory may live in another thread than this planner
+    QMetaObject::invokeMethod(this->fragmentsFactory(), "getPage", Qt::AutoConnection,
+                              Q_ARG(QUrl, uri), Q_ARG(QObject *, this), Q_ARG(quint64, m_queryGeneration));
+}
+
+void QRail::RouterEngine::Planner::requestPage(const QDateTime &departureTime)
+{
+    // The Fragments::Factory may live in another thread than this planner
+    QMetaObject::invokeMethod(this->fragmentsFactory(), "getPage", Qt::AutoConnection,
+                              Q_ARG(QDateTime, departureTime), Q_ARG(QObject *, this), Q_ARG(quint64, m_queryGeneration));
+}
+
+void QRail::RouterEngine::Planner::prefetchPages(const QUrl &uri, QRail::Fragments::Factory::Direction direction)
+{
+    // The Fragments::Factory may live in another thread than this planner
+    QMetaObject::invokeMethod(this->fragmentsFactory(), "prefetchPages", Qt::AutoConnection,
+                              Q_ARG(QUrl, uri), Q_ARG(quint16, this->prefetchDepth()),
+                              Q_ARG(QRail::Fragments::Factory::Direction, direction));
+}
+
 // Getters & Setters
 /*void QRail::RouterEngine::Planner::customEvent(QEvent *event)
 {
@@ -1083,8 +1577,10 @@ QDateTime QRail::RouterEngine::Planner::calculateArrivalTime(const QDateTime &de
 
 void RouterEngine::Planner::unlockPlanner()
 {
-    // Timeout timer isn't necessary anymore
+    // Timeout timers aren't necessary anymore
     this->progressTimeoutTimer->stop();
+    this->deadlineTimer->stop();
+    m_isRunning = false;
 
     // Make planner accessible again
     this->plannerProcessingMutex.unlock();
@@ -1095,42 +1591,71 @@ void RouterEngine::Planner::handleTimeout()
     qCritical() << "Planner timed out, ABORTING NOW";
     this->setAbortRequested(true);
     emit this->error("Planner timed out, the operation has been aborted!");
+    if (this->isBatchRunning()) {
+        this->finishBatch();
+        return;
+    }
     emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
 }
 
+void RouterEngine::Planner::handleDeadline()
+{
+    // Batches and reroutes don't have a deadline
+    if (!m_isRunning || this->isBatchRunning() || !this->journey()) {
+        return;
+    }
+
+    /*
+    * The routes are extracted after every page, the routes found so far are
+    * valid but routes departing earlier might be missing. During the forward
+    * search no profiles are available yet.
+    */
+    qInfo() << "Planner deadline reached, returning partial result";
+    m_forwardSearch = false;
+    this->journey()->setPartial(true);
+    this->finishJourney();
+}
+
 void RouterEngine::Planner::handleFragmentFactoryError()
 {
     qCritical() << "Planner fragment factory error, ABORTING NOW";
     this->setAbortRequested(true);
     emit this->error("Planner fragment factory error, the operation has been aborted!");
+    if (this->isBatchRunning()) {
+        this->finishBatch();
+        return;
+    }
     emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
 }
 
 void RouterEngine::Planner::handleFragmentAndPageFactoryUpdate(QSharedPointer<QRail::Fragments::Fragment> fragment, QUrl pageURI)
 {
+    if(!this->isBackgroundUpdatesEnabled()) {
+        return;
+    }
+
+    // Look up the watched route legs which use this connection
     qDebug() << "Planner affected?" << pageURI.toString() << "FRAG=" << fragment->uri().toString();
+    const QList<QRail::RouterEngine::Planner::WatchedLeg> watchedLegs = m_watchIndex.value(fragment->uri());
     bool isAffected = false;
-
-    // If a fragment used in the CSA planning that has been updated, flag it
-    foreach(QSharedPointer<QRail::RouterEngine::Route> route, this->journey()->routes()) {
-        foreach(QSharedPointer<QRail::RouterEngine::RouteLeg> leg, route->legs()) {
-            qDebug() << "Fragment:" << fragment->uri();
-            qDebug() << "Route leg: " << leg->departure()->uri() << "to" << leg->arrival()->uri();
-            if(leg->departure()->uri() == fragment->uri() || leg->arrival()->uri() == fragment->uri()) {
-                qDebug() << "Fragment used in routing has been updated!" << fragment->uri();
-                isAffected = true;
-                break;
-            }
+    QList<QRail::RouterEngine::Journey *> affectedJourneys;
+    foreach(QRail::RouterEngine::Planner::WatchedLeg watchedLeg, watchedLegs) {
+        if(watchedLeg.journey == this->journey()) {
+            qDebug() << "Fragment used in routing has been updated!" << fragment->uri();
+            isAffected = true;
         }
-
-        if(isAffected) {
-            break;
+        else if(!affectedJourneys.contains(watchedLeg.journey)) {
+            affectedJourneys.append(watchedLeg.journey);
         }
     }
 
-    qDebug() << "--------------------------------";
+    // Watched journeys which aren't planned by this planner right now are reported
+    foreach(QRail::RouterEngine::Journey *journey, affectedJourneys) {
+        emit this->watchedJourneyUpdated(journey, fragment);
+    }
 
     if(isAffected) {
+        m_updatedFragments.insert(fragment->uri(), fragment);
         if(fragmentUpdateTimestamp.isValid()) {
             // The fragment(connection) that has been updated is further in the future than the current timestamp, update it
             if(fragmentUpdateTimestamp < fragment->departureTime()) {
@@ -1148,6 +1673,27 @@ void RouterEngine::Planner::handleFragmentAndPageFactoryUpdate(QSharedPointer<QR
     }
 }
 
+void RouterEngine::Planner::scheduleUpdate()
+{
+    // Update batch didn't touch any route of the Journey
+    if(!this->isBackgroundUpdatesEnabled() || !pageUpdateURI.isValid()) {
+        qDebug() << "No relevant updates, skipping reroute";
+        return;
+    }
+
+    // Coalescing disabled, process right away
+    if(this->updateCoalescingInterval() <= 0) {
+        this->processUpdate();
+        return;
+    }
+
+    // Update batches arriving during the window are merged into a single reroute
+    if(!this->updateCoalescingTimer->isActive()) {
+        qDebug() << "Update scheduled in" << this->updateCoalescingInterval() << "ms";
+        this->updateCoalescingTimer->start();
+    }
+}
+
 void RouterEngine::Planner::processUpdate()
 {
     if(!pageUpdateURI.isValid()) {
@@ -1155,9 +1701,42 @@ void RouterEngine::Planner::processUpdate()
         return;
     }
 
+    // Wait until the running query or reroute is finished, the updates are kept until then
+    if(m_isRunning) {
+        qDebug() << "Planner is busy, postponing update";
+        this->updateCoalescingTimer->start(qMax(this->updateCoalescingInterval(), MINIMUM_UPDATE_RETRY_INTERVAL));
+        return;
+    }
+
     qDebug() << "Start processing update...";
     emit this->startReroute();
 
+    // Small changes which keep the routes valid are applied to the routes directly
+    if(this->isIncrementalUpdatesEnabled()
+            && m_updatedFragments.size() <= INCREMENTAL_UPDATE_MAX_FRAGMENTS
+            && this->applyIncrementalUpdate()) {
+        qDebug() << "Update applied incrementally, no reroute needed";
+
+        // The profiles of this page are outdated now, roll back to it on the next reroute
+        if(!incrementalUpdateTimestamp.isValid() || incrementalUpdateTimestamp < fragmentUpdateTimestamp) {
+            incrementalUpdateTimestamp = fragmentUpdateTimestamp;
+            incrementalUpdatePageURI = pageUpdateURI;
+        }
+        fragmentUpdateTimestamp = this->journey()->departureTime();
+        pageUpdateURI = QUrl();
+        m_updatedFragments.clear();
+        emit this->updateProcessed();
+        return;
+    }
+
+    // Profiles of incrementally updated pages must be rescanned too
+    if(incrementalUpdateTimestamp.isValid() && incrementalUpdateTimestamp > fragmentUpdateTimestamp) {
+        pageUpdateURI = incrementalUpdatePageURI;
+    }
+    incrementalUpdateTimestamp = QDateTime();
+    incrementalUpdatePageURI = QUrl();
+    m_updatedFragments.clear();
+
     // Restore journey to previous snapshot
     qDebug() << "Restoring journey to snapshot:" << pageUpdateURI.toString();
     QDateTime timestamp = this->journey()->restoreBeforePage(pageUpdateURI);
@@ -1175,6 +1754,224 @@ void RouterEngine::Planner::processUpdate()
     emit this->updateProcessed();
 }
 
+bool RouterEngine::Planner::applyIncrementalUpdate()
+{
+    /*
+    * Only the routes which use an updated connection are re-evaluated.
+    * The update can be applied without rescanning the pages when for every
+    * affected route:
+    *   - all transfers are still possible with the new times
+    *   - the arrival time doesn't become later, otherwise routes which were
+    *     dominated by this route might be part of the Pareto front now.
+    * When these conditions aren't met, nothing is modified and the caller
+    * falls back on the rollback.
+    * Routes are shared with the application and the journey cache, the
+    * affected routes are replaced by new Route objects instead of being
+    * modified in place.
+    */
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+    QList<QSharedPointer<QRail::RouterEngine::Route> > replacedRoutes;
+    QList<QSharedPointer<QRail::RouterEngine::Route> > updatedRoutes;
+    foreach(QSharedPointer<QRail::RouterEngine::Route> route, this->journey()->routes()) {
+        QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > legs;
+        bool isChanged = false;
+        QDateTime previousArrivalTime;
+        foreach(QSharedPointer<QRail::RouterEngine::RouteLeg> leg, route->legs()) {
+            QSharedPointer<QRail::RouterEngine::RouteLegEnd> departure = this->updateRouteLegEnd(leg->departure(), true);
+            QSharedPointer<QRail::RouterEngine::RouteLegEnd> arrival = this->updateRouteLegEnd(leg->arrival(), false);
+
+            // Transfer must still be possible
+            if(previousArrivalTime.isValid() && previousArrivalTime.addSecs(INTRA_STOP_FOOTPATH_TIME) > departure->time()) {
+                qDebug() << "Transfer isn't possible anymore, rollback required";
+                return false;
+            }
+            previousArrivalTime = arrival->time();
+
+            // Legs without new times are shared with the previous Route
+            if(departure != leg->departure() || arrival != leg->arrival()) {
+                leg = QSharedPointer<QRail::RouterEngine::RouteLeg>::create(leg->type(), leg->vehicleInformation(), departure, arrival);
+                isChanged = true;
+            }
+            legs.append(leg);
+        }
+
+        if(!isChanged) {
+            routes.append(route);
+            continue;
+        }
+
+        if(previousArrivalTime > route->arrivalTime()) {
+            qDebug() << "Route arrives later, rollback required";
+            return false;
+        }
+
+        QSharedPointer<QRail::RouterEngine::Route> updatedRoute = QSharedPointer<QRail::RouterEngine::Route>::create(legs);
+        updatedRoute->setTripAlerts(route->tripAlerts());
+        updatedRoute->setVehicleAlerts(route->vehicleAlerts());
+        updatedRoute->setRemarks(route->remarks());
+        routes.append(updatedRoute);
+        replacedRoutes.append(route);
+        updatedRoutes.append(updatedRoute);
+    }
+
+    // All affected routes are still valid, watch the new legs instead of the replaced ones
+    for(qint32 r = 0; r < replacedRoutes.size(); r++) {
+        QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > replacedLegs = replacedRoutes.at(r)->legs();
+        QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > updatedLegs = updatedRoutes.at(r)->legs();
+        for(qint32 l = 0; l < replacedLegs.size(); l++) {
+            QList<QUrl> uris;
+            uris << replacedLegs.at(l)->departure()->uri() << replacedLegs.at(l)->arrival()->uri();
+            foreach(QUrl uri, uris) {
+                if(!m_watchIndex.contains(uri)) {
+                    continue;
+                }
+                QList<QRail::RouterEngine::Planner::WatchedLeg> &watchedLegs = m_watchIndex[uri];
+                for(qint32 i = 0; i < watchedLegs.size(); i++) {
+                    if(watchedLegs.at(i).leg == replacedLegs.at(l)) {
+                        watchedLegs[i].route = updatedRoutes.at(r);
+                        watchedLegs[i].leg = updatedLegs.at(l);
+                    }
+                }
+            }
+        }
+    }
+
+    // Departure times might have changed, keep the routes sorted
+    std::sort(routes.begin(), routes.end(), [](const QSharedPointer<QRail::RouterEngine::Route> a,
+              const QSharedPointer<QRail::RouterEngine::Route> b) -> bool {
+        return a->departureTime() < b->departureTime();
+    });
+    this->journey()->setRoutes(routes);
+
+    // Only routes with new times are streamed again
+    foreach(QSharedPointer<QRail::RouterEngine::Route> route, updatedRoutes) {
+        emit this->stream(route);
+    }
+
+    return true;
+}
+
+QSharedPointer<QRail::RouterEngine::RouteLegEnd> RouterEngine::Planner::updateRouteLegEnd(const QSharedPointer<QRail::RouterEngine::RouteLegEnd> &legEnd,
+                                                                                          const bool isDeparture) const
+{
+    if(!m_updatedFragments.contains(legEnd->uri())) {
+        return legEnd;
+    }
+
+    QSharedPointer<QRail::Fragments::Fragment> fragment = m_updatedFragments.value(legEnd->uri());
+    QDateTime time = isDeparture? fragment->departureTime(): fragment->arrivalTime();
+    qint16 delay = isDeparture? fragment->departureDelay(): fragment->arrivalDelay();
+    if(time == legEnd->time() && delay == legEnd->delay()) {
+        return legEnd;
+    }
+
+    return QSharedPointer<QRail::RouterEngine::RouteLegEnd>::create(legEnd->uri(),
+                                                                    time,
+                                                                    legEnd->station(),
+                                                                    legEnd->platform(),
+                                                                    legEnd->isNormalPlatform(),
+                                                                    delay,
+                                                                    legEnd->isCanceled(),
+                                                                    legEnd->isPassed(),
+                                                                    legEnd->occupancyLevel());
+}
+
+QRail::RouterEngine::JourneyCache *QRail::RouterEngine::Planner::journeyCache() const
+{
+    return m_journeyCache;
+}
+
+void QRail::RouterEngine::Planner::setJourneyCache(QRail::RouterEngine::JourneyCache *journeyCache)
+{
+    if (!journeyCache || journeyCache == m_journeyCache) {
+        return;
+    }
+
+    // Only the cache created by this Planner is owned and invalidated by it
+    if (m_journeyCache->parent() == this) {
+        disconnect(this->fragmentsFactory(), nullptr, m_journeyCache, nullptr);
+        m_journeyCache->deleteLater();
+    }
+    m_journeyCache = journeyCache;
+}
+
+QRail::RouterEngine::DestinationCache *QRail::RouterEngine::Planner::destinationCache() const
+{
+    return m_destinationCache;
+}
+
+void QRail::RouterEngine::Planner::setDestinationCache(QRail::RouterEngine::DestinationCache *destinationCache)
+{
+    if (!destinationCache || destinationCache == m_destinationCache) {
+        return;
+    }
+
+    // Only the cache created by this Planner is owned by it
+    if (m_destinationCache->parent() == this) {
+        m_destinationCache->deleteLater();
+    }
+    m_destinationCache = destinationCache;
+}
+
+qint32 QRail::RouterEngine::Planner::destinationCacheSize() const
+{
+    return this->destinationCache()->maxSize();
+}
+
+void QRail::RouterEngine::Planner::setDestinationCacheSize(const qint32 destinationCacheSize)
+{
+    this->destinationCache()->setMaxSize(destinationCacheSize);
+}
+
+qint32 QRail::RouterEngine::Planner::updateCoalescingInterval() const
+{
+    return m_updateCoalescingInterval;
+}
+
+void QRail::RouterEngine::Planner::setUpdateCoalescingInterval(const qint32 updateCoalescingInterval)
+{
+    m_updateCoalescingInterval = updateCoalescingInterval;
+    if(updateCoalescingInterval > 0) {
+        this->updateCoalescingTimer->setInterval(updateCoalescingInterval);
+    }
+}
+
+bool QRail::RouterEngine::Planner::isIncrementalUpdatesEnabled() const
+{
+    return m_incrementalUpdatesEnabled;
+}
+
+void QRail::RouterEngine::Planner::setIncrementalUpdatesEnabled(const bool incrementalUpdatesEnabled)
+{
+    m_incrementalUpdatesEnabled = incrementalUpdatesEnabled;
+}
+
+bool QRail::RouterEngine::Planner::isBackgroundUpdatesEnabled() const
+{
+    return m_backgroundUpdatesEnabled;
+}
+
+void QRail::RouterEngine::Planner::setBackgroundUpdatesEnabled(const bool backgroundUpdatesEnabled)
+{
+    m_backgroundUpdatesEnabled = backgroundUpdatesEnabled;
+
+    // Polling reroutes only exist without a real time subscription
+    if (m_timer) {
+        if (m_backgroundUpdatesEnabled) {
+            m_timer->start(POLL_INTERVAL);
+        } else {
+            m_timer->stop();
+        }
+    }
+
+    // Drop updates which were collected before
+    if (!m_backgroundUpdatesEnabled) {
+        this->updateCoalescingTimer->stop();
+        pageUpdateURI = QUrl();
+        m_updatedFragments.clear();
+    }
+}
+
 QRail::RouterEngine::Journey *QRail::RouterEngine::Planner::journey() const
 {
     return m_journey;
@@ -1182,9 +1979,48 @@ QRail::RouterEngine::Journey *QRail::RouterEngine::Planner::journey() const
 
 void QRail::RouterEngine::Planner::setJourney(QRail::RouterEngine::Journey *journey)
 {
+    // The previous Journey doesn't receive updates anymore unless it's watched
+    if(m_journey && m_journey != journey && !m_watchList.contains(m_journey)) {
+        this->unindexJourney(m_journey);
+    }
     m_journey = journey;
 }
 
+bool QRail::RouterEngine::Planner::isGeographicPruningEnabled() const
+{
+    return m_geographicPruningEnabled;
+}
+
+void QRail::RouterEngine::Planner::setGeographicPruningEnabled(const bool geographicPruningEnabled)
+{
+    m_geographicPruningEnabled = geographicPruningEnabled;
+}
+
+bool QRail::RouterEngine::Planner::isForwardSearchEnabled() const
+{
+    return m_forwardSearchEnabled;
+}
+
+void QRail::RouterEngine::Planner::setForwardSearchEnabled(const bool forwardSearchEnabled)
+{
+    m_forwardSearchEnabled = forwardSearchEnabled;
+}
+
+quint16 QRail::RouterEngine::Planner::prefetchDepth() const
+{
+    return m_prefetchDepth;
+}
+
+void QRail::RouterEngine::Planner::setPrefetchDepth(const quint16 prefetchDepth)
+{
+    m_prefetchDepth = prefetchDepth;
+}
+
+bool QRail::RouterEngine::Planner::isBatchRunning() const
+{
+    return !m_batchJourneys.isEmpty();
+}
+
 bool QRail::RouterEngine::Planner::isAbortRequested() const
 {
     return m_abortRequested;
@@ -1202,19 +2038,96 @@ QRail::Fragments::Factory *QRail::RouterEngine::Planner::fragmentsFactory() cons
 
 void RouterEngine::Planner::watch(RouterEngine::Journey *journey)
 {
+    if(!journey || m_watchList.contains(journey)) {
+        return;
+    }
     m_watchList.append(journey);
+    this->indexJourney(journey);
 }
 
 void RouterEngine::Planner::unwatch(RouterEngine::Journey *journey)
 {
     m_watchList.removeAll(journey);
+    if(journey != this->journey()) {
+        this->unindexJourney(journey);
+    }
 }
 
 void RouterEngine::Planner::unwatchAll()
 {
+    foreach(RouterEngine::Journey *journey, m_watchList) {
+        if(journey != this->journey()) {
+            this->unindexJourney(journey);
+        }
+    }
     m_watchList.clear();
 }
 
+void RouterEngine::Planner::indexJourney(RouterEngine::Journey *journey)
+{
+    // Routes might have changed since the last time, start from scratch for this Journey
+    this->unindexJourney(journey);
+
+    QList<QUrl> uris;
+    foreach(QSharedPointer<QRail::RouterEngine::Route> route, journey->routes()) {
+        foreach(QSharedPointer<QRail::RouterEngine::RouteLeg> leg, route->legs()) {
+            QRail::RouterEngine::Planner::WatchedLeg watchedLeg;
+            watchedLeg.journey = journey;
+            watchedLeg.route = route;
+            watchedLeg.leg = leg;
+            m_watchIndex[leg->departure()->uri()].append(watchedLeg);
+            m_watchIndex[leg->arrival()->uri()].append(watchedLeg);
+            uris.append(leg->departure()->uri());
+            uris.append(leg->arrival()->uri());
+        }
+    }
+    m_watchedURIs.insert(journey, uris);
+
+    // The index only holds raw pointers, forget the Journey when it's destroyed
+    connect(journey, SIGNAL(destroyed(QObject*)), this, SLOT(handleJourneyDestroyed(QObject*)), Qt::UniqueConnection);
+
+    // Keep the pages of the Journey in memory, updates of its connections are applied to them
+    QList<QUrl> pageURIs = journey->pageURIs();
+    if(!pageURIs.isEmpty()) {
+        m_pinnedPages.insert(journey, pageURIs);
+        QMetaObject::invokeMethod(this->fragmentsFactory()->pageCache(), "pinPages", Qt::AutoConnection,
+                                  Q_ARG(QList<QUrl>, pageURIs));
+    }
+}
+
+void RouterEngine::Planner::unindexJourney(RouterEngine::Journey *journey)
+{
+    // Only visit the URIs used by this Journey
+    foreach(QUrl uri, m_watchedURIs.take(journey)) {
+        QList<QRail::RouterEngine::Planner::WatchedLeg> &watchedLegs = m_watchIndex[uri];
+        for(qint32 i = watchedLegs.size() - 1; i >= 0; i--) {
+            if(watchedLegs.at(i).journey == journey) {
+                watchedLegs.removeAt(i);
+            }
+        }
+        if(watchedLegs.isEmpty()) {
+            m_watchIndex.remove(uri);
+        }
+    }
+
+    QList<QUrl> pageURIs = m_pinnedPages.take(journey);
+    if(!pageURIs.isEmpty()) {
+        QMetaObject::invokeMethod(this->fragmentsFactory()->pageCache(), "unpinPages", Qt::AutoConnection,
+                                  Q_ARG(QList<QUrl>, pageURIs));
+    }
+}
+
+void RouterEngine::Planner::handleJourneyDestroyed(QObject *object)
+{
+    // The Journey is being destroyed, its pointer is only used as a key here
+    RouterEngine::Journey *journey = static_cast<RouterEngine::Journey *>(object);
+    m_watchList.removeAll(journey);
+    this->unindexJourney(journey);
+    if(m_journey == journey) {
+        m_journey = nullptr;
+    }
+}
+
 void QRail::RouterEngine::Planner::setFragmentsFactory(QRail::Fragments::Factory *factory)
 {
     m_fragmentsFactory = factory;
@@ -0,0 +1,311 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "engines/router/routerplannerpool.h"
+using namespace QRail;
+QRail::RouterEngine::PlannerPool *QRail::RouterEngine::PlannerPool::m_instance = nullptr;
+
+QRail::RouterEngine::PlannerPool::PlannerPool(QRail::Network::EventSource::Subscription subscriptionType, const qint32 size, QObject *parent) : QObject(parent)
+{
+    // Types which are passed between the worker threads
+    qRegisterMetaType<QSharedPointer<QRail::Fragments::Page> >("QSharedPointer<QRail::Fragments::Page>");
+    qRegisterMetaType<QSharedPointer<QRail::RouterEngine::Route> >("QSharedPointer<QRail::RouterEngine::Route>");
+    qRegisterMetaType<QRail::RouterEngine::Journey *>("QRail::RouterEngine::Journey*");
+    qRegisterMetaType<QRail::Fragments::Factory::Direction>("QRail::Fragments::Factory::Direction");
+    qRegisterMetaType<QRail::RouterEngine::Query>("QRail::RouterEngine::Query");
+    qRegisterMetaType<QList<QUrl> >("QList<QUrl>");
+    m_nextRangeID = 0;
+
+    // Shared Fragments::Factory, must be created in this thread before the planners are moved
+    QRail::Fragments::Factory *fragmentsFactory = QRail::Fragments::Factory::getInstance(subscriptionType);
+
+    // A query answered by one planner is answered from the cache by every other planner, updates invalidate it once
+    m_journeyCache = new QRail::RouterEngine::JourneyCache(this);
+    connect(fragmentsFactory, SIGNAL(pageUpdated(QUrl)), m_journeyCache, SLOT(invalidatePage(QUrl)));
+    connect(fragmentsFactory, SIGNAL(fragmentUpdated(QSharedPointer<QRail::Fragments::Fragment>)),
+            m_journeyCache, SLOT(invalidateFragment(QSharedPointer<QRail::Fragments::Fragment>)));
+
+    // Profiles towards a destination computed by one planner answer the queries of every other planner
+    m_destinationCache = new QRail::RouterEngine::DestinationCache(this);
+
+    for (qint32 i = 0; i < size; i++) {
+        QThread *thread = new QThread(this);
+        QRail::RouterEngine::Planner *planner = new QRail::RouterEngine::Planner(subscriptionType);
+        planner->setBackgroundUpdatesEnabled(false);
+        planner->setJourneyCache(m_journeyCache);
+        planner->setDestinationCache(m_destinationCache);
+        planner->moveToThread(thread);
+        connect(thread, SIGNAL(finished()), planner, SLOT(deleteLater()));
+        connect(planner, SIGNAL(finished(QRail::RouterEngine::Journey*)), this, SLOT(handlePlannerFinished(QRail::RouterEngine::Journey*)));
+        connect(planner, SIGNAL(stream(QSharedPointer<QRail::RouterEngine::Route>)), this, SIGNAL(stream(QSharedPointer<QRail::RouterEngine::Route>)));
+        connect(planner, SIGNAL(error(QString)), this, SIGNAL(error(QString)));
+        thread->start();
+        m_threads.append(thread);
+        m_planners.append(planner);
+        m_idlePlanners.append(planner);
+    }
+    qDebug() << "Planner pool started with" << size << "planners";
+}
+
+QRail::RouterEngine::PlannerPool::~PlannerPool()
+{
+    foreach (QThread *thread, m_threads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+QRail::RouterEngine::PlannerPool *QRail::RouterEngine::PlannerPool::getInstance(QRail::Network::EventSource::Subscription subscriptionType)
+{
+    // Singleton pattern
+    if (m_instance == nullptr) {
+        qDebug() << "Generating new QRail::RouterEngine::PlannerPool";
+        m_instance = new PlannerPool(subscriptionType, qMax(QThread::idealThreadCount(), 1));
+    }
+    return m_instance;
+}
+
+// Invokers
+void QRail::RouterEngine::PlannerPool::getConnections(const QUrl &departureStation,
+                                                      const QUrl &arrivalStation,
+                                                      const QDateTime &departureTime,
+                                                      const quint16 &maxTransfers)
+{
+    QRail::RouterEngine::Query query = QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, maxTransfers);
+    if (!query.isValid()) {
+        qCritical() << "Invalid stations or timestamps";
+        qCritical() << "Departure station:" << departureStation;
+        qCritical() << "Arrival station:" << arrivalStation;
+        qCritical() << "Departure time:" << departureTime;
+        emit this->error("Invalid stations or timestamps!");
+        return;
+    }
+
+    QMutexLocker locker(&m_poolMutex);
+    this->schedule(query, -1);
+}
+
+void QRail::RouterEngine::PlannerPool::getConnections(const QUrl &departureStation,
+                                                      const QUrl &arrivalStation,
+                                                      const QDateTime &departureTime,
+                                                      const QDateTime &latestDepartureTime,
+                                                      const quint16 &maxTransfers,
+                                                      const qint32 slices)
+{
+    QRail::RouterEngine::Query query = QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, maxTransfers, latestDepartureTime);
+    if (!query.isValid() || !latestDepartureTime.isValid()) {
+        qCritical() << "Invalid stations or departure time window";
+        qCritical() << "Departure station:" << departureStation;
+        qCritical() << "Arrival station:" << arrivalStation;
+        qCritical() << "Departure time:" << departureTime;
+        qCritical() << "Latest departure time:" << latestDepartureTime;
+        emit this->error("Invalid stations or departure time window!");
+        return;
+    }
+
+    /*
+    * The slices are independent range queries: every slice scans from its own
+    * arrival time bound down to its own departure time. Connections after the
+    * end of a slice are scanned again by the slice itself, which keeps each
+    * scan exact without waiting for the profiles of the later slices.
+    * A route departing on the boundary of 2 slices is only returned by the
+    * earlier slice, the latest departure time of a slice is inclusive.
+    */
+    QList<QRail::RouterEngine::Query> sliceQueries = query.slices(slices > 0? slices: this->size());
+    QMutexLocker locker(&m_poolMutex);
+    qint32 rangeID = m_nextRangeID++;
+    QRail::RouterEngine::PlannerPool::Range range;
+    range.query = query;
+    range.remainingSlices = sliceQueries.size();
+    m_ranges.insert(rangeID, range);
+    qDebug() << "Range query split into" << range.remainingSlices << "slices";
+
+    foreach (QRail::RouterEngine::Query sliceQuery, sliceQueries) {
+        this->schedule(sliceQuery, rangeID);
+    }
+}
+
+QRail::RouterEngine::JourneyCache *QRail::RouterEngine::PlannerPool::journeyCache() const
+{
+    return m_journeyCache;
+}
+
+QRail::RouterEngine::DestinationCache *QRail::RouterEngine::PlannerPool::destinationCache() const
+{
+    return m_destinationCache;
+}
+
+qint32 QRail::RouterEngine::PlannerPool::size() const
+{
+    return m_planners.size();
+}
+
+qint32 QRail::RouterEngine::PlannerPool::pendingQueries() const
+{
+    QMutexLocker locker(&m_poolMutex);
+    return m_pendingTasks.size();
+}
+
+// Processors
+void QRail::RouterEngine::PlannerPool::handlePlannerFinished(QRail::RouterEngine::Journey *journey)
+{
+    QRail::RouterEngine::Planner *planner = qobject_cast<QRail::RouterEngine::Planner *>(this->sender());
+    bool isSlice = false;
+    bool isRangeFinished = false;
+    QRail::RouterEngine::PlannerPool::Range finishedRange;
+    if (planner) {
+        QMutexLocker locker(&m_poolMutex);
+
+        // Only results of the queries dispatched by the pool are reported
+        if (!m_runningTasks.contains(planner)) {
+            qWarning() << "Ignoring result of a query which wasn't dispatched by the pool";
+            return;
+        }
+
+        // Slices of a range query are merged once every slice is finished
+        qint32 rangeID = m_runningTasks.take(planner).rangeID;
+        if (rangeID >= 0) {
+            isSlice = true;
+            m_ranges[rangeID].journeys.append(journey);
+            m_ranges[rangeID].remainingSlices--;
+            if (m_ranges.value(rangeID).remainingSlices <= 0) {
+                finishedRange = m_ranges.take(rangeID);
+                isRangeFinished = true;
+            }
+        }
+
+        // Run the next query on this planner or mark it as idle
+        if (!m_pendingTasks.isEmpty()) {
+            this->dispatch(planner, m_pendingTasks.takeFirst());
+        } else if (!m_idlePlanners.contains(planner)) {
+            m_idlePlanners.append(planner);
+        }
+    }
+
+    if (isSlice) {
+        if (!isRangeFinished) {
+            return;
+        }
+
+        QRail::RouterEngine::Journey *mergedJourney = this->mergeRange(finishedRange);
+        if (mergedJourney->routes().size() == 0) {
+            mergedJourney->deleteLater();
+            emit this->error("No routes found!");
+            emit this->finished(QRail::RouterEngine::NullJourney::getInstance());
+            return;
+        }
+        emit this->finished(mergedJourney);
+        return;
+    }
+
+    emit this->finished(journey);
+}
+
+// Helpers
+void QRail::RouterEngine::PlannerPool::schedule(const QRail::RouterEngine::Query &query, const qint32 rangeID)
+{
+    QRail::RouterEngine::PlannerPool::Task task;
+    task.query = query;
+    task.rangeID = rangeID;
+    if (m_idlePlanners.isEmpty()) {
+        qDebug() << "All planners are busy, queueing query";
+        m_pendingTasks.append(task);
+        return;
+    }
+    this->dispatch(m_idlePlanners.takeFirst(), task);
+}
+
+void QRail::RouterEngine::PlannerPool::dispatch(QRail::RouterEngine::Planner *planner, const QRail::RouterEngine::PlannerPool::Task &task)
+{
+    m_runningTasks.insert(planner, task);
+
+    // The planner lives in a worker thread, queue the call in its event loop
+    QMetaObject::invokeMethod(planner, "getConnections", Qt::QueuedConnection,
+                              Q_ARG(QRail::RouterEngine::Query, task.query),
+                              Q_ARG(qint32, 0));
+}
+
+QRail::RouterEngine::Journey *QRail::RouterEngine::PlannerPool::mergeRange(const QRail::RouterEngine::PlannerPool::Range &range)
+{
+    QRail::RouterEngine::Journey *mergedJourney = new QRail::RouterEngine::Journey(this);
+    mergedJourney->setDepartureStationURI(range.query.departureStation());
+    mergedJourney->setArrivalStationURI(range.query.arrivalStation());
+    mergedJourney->setDepartureTime(range.query.departureTime());
+    mergedJourney->setLatestDepartureTime(range.query.latestDepartureTime());
+    mergedJourney->setMaxTransfers(range.query.maxTransfers());
+
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+    foreach (QRail::RouterEngine::Journey *journey, range.journeys) {
+        if (journey == QRail::RouterEngine::NullJourney::getInstance()) {
+            continue;
+        }
+
+        routes.append(journey->routes());
+        foreach (QUrl pageURI, journey->pageURIs()) {
+            mergedJourney->addPageURI(pageURI);
+        }
+        if (!mergedJourney->arrivalTime().isValid() || journey->arrivalTime() > mergedJourney->arrivalTime()) {
+            mergedJourney->setArrivalTime(journey->arrivalTime());
+        }
+        if (journey->isPartial()) {
+            mergedJourney->setPartial(true);
+        }
+    }
+
+    QList<QSharedPointer<QRail::RouterEngine::Route> > paretoRoutes = QRail::RouterEngine::PlannerPool::paretoRoutes(routes);
+    mergedJourney->setRoutes(paretoRoutes);
+    qDebug() << "Merged" << range.journeys.size() << "slices into" << paretoRoutes.size() << "routes";
+    return mergedJourney;
+}
+
+QList<QSharedPointer<QRail::RouterEngine::Route> > QRail::RouterEngine::PlannerPool::paretoRoutes(const QList<QSharedPointer<QRail::RouterEngine::Route> > &routes)
+{
+    /*
+    * Each slice only knows the routes departing in its own window, a route of
+    * an earlier slice can be dominated by a later departing route which
+    * arrives at the same time or earlier with the same or less transfers.
+    */
+    QList<QSharedPointer<QRail::RouterEngine::Route> > paretoRoutes;
+    foreach (QSharedPointer<QRail::RouterEngine::Route> route, routes) {
+        bool isDominated = false;
+        foreach (QSharedPointer<QRail::RouterEngine::Route> other, routes) {
+            if (other == route) {
+                continue;
+            }
+
+            if (other->departureTime() >= route->departureTime()
+                    && other->arrivalTime() <= route->arrivalTime()
+                    && other->transfers().size() <= route->transfers().size()
+                    && (other->departureTime() > route->departureTime()
+                        || other->arrivalTime() < route->arrivalTime()
+                        || other->transfers().size() < route->transfers().size())) {
+                isDominated = true;
+                break;
+            }
+        }
+
+        if (!isDominated) {
+            paretoRoutes.append(route);
+        }
+    }
+
+    std::sort(paretoRoutes.begin(), paretoRoutes.end(), [](
+              const QSharedPointer<QRail::RouterEngine::Route> &a,
+              const QSharedPointer<QRail::RouterEngine::Route> &b) -> bool {
+        return a->departureTime() < b->departureTime();
+    });
+    return paretoRoutes;
+}
@@ -0,0 +1,93 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "engines/router/routerquery.h"
+using namespace QRail;
+
+QRail::RouterEngine::Query::Query()
+{
+    m_departureStation = QUrl();
+    m_arrivalStation = QUrl();
+    m_departureTime = QDateTime();
+    m_latestDepartureTime = QDateTime();
+    m_maxTransfers = 0;
+}
+
+QRail::RouterEngine::Query::Query(const QUrl &departureStation,
+                                  const QUrl &arrivalStation,
+                                  const QDateTime &departureTime,
+                                  const quint16 &maxTransfers,
+                                  const QDateTime &latestDepartureTime)
+{
+    m_departureStation = departureStation;
+    m_arrivalStation = arrivalStation;
+    m_departureTime = departureTime;
+    m_latestDepartureTime = latestDepartureTime;
+    m_maxTransfers = maxTransfers;
+}
+
+QUrl QRail::RouterEngine::Query::departureStation() const
+{
+    return m_departureStation;
+}
+
+QUrl QRail::RouterEngine::Query::arrivalStation() const
+{
+    return m_arrivalStation;
+}
+
+QDateTime QRail::RouterEngine::Query::departureTime() const
+{
+    return m_departureTime;
+}
+
+QDateTime QRail::RouterEngine::Query::latestDepartureTime() const
+{
+    return m_latestDepartureTime;
+}
+
+quint16 QRail::RouterEngine::Query::maxTransfers() const
+{
+    return m_maxTransfers;
+}
+
+bool QRail::RouterEngine::Query::isValid() const
+{
+    return m_departureStation.isValid() && m_arrivalStation.isValid() && m_departureTime.isValid()
+           && (!m_latestDepartureTime.isValid() || m_latestDepartureTime > m_departureTime);
+}
+
+bool QRail::RouterEngine::Query::isInDepartureWindow(const QDateTime &departureTime) const
+{
+    return departureTime > m_departureTime && (!m_latestDepartureTime.isValid() || departureTime <= m_latestDepartureTime);
+}
+
+QList<QRail::RouterEngine::Query> QRail::RouterEngine::Query::slices(const qint32 count) const
+{
+    QList<QRail::RouterEngine::Query> sliceQueries;
+    if (!m_latestDepartureTime.isValid() || count <= 1) {
+        sliceQueries.append(*this);
+        return sliceQueries;
+    }
+
+    qint64 window = m_departureTime.msecsTo(m_latestDepartureTime);
+    qint64 sliceLength = qMax((window + count - 1) / count, static_cast<qint64>(1));
+    for (QDateTime sliceStart = m_departureTime; sliceStart < m_latestDepartureTime; sliceStart = sliceStart.addMSecs(sliceLength)) {
+        QDateTime sliceEnd = qMin(sliceStart.addMSecs(sliceLength), m_latestDepartureTime);
+        sliceQueries.append(QRail::RouterEngine::Query(m_departureStation, m_arrivalStation, sliceStart, m_maxTransfers, sliceEnd));
+    }
+    return sliceQueries;
+}
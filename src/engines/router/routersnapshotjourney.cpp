@@ -19,27 +19,20 @@ using namespace QRail;
 using namespace RouterEngine;
 
 
-SnapshotJourney::SnapshotJourney(QUrl pageURI, 
+SnapshotJourney::SnapshotJourney(QUrl pageURI,
                              QUrl hydraNext,
                              QUrl hydraPrevious,
-                             QList<QSharedPointer<QRail::RouterEngine::Route> > routes,
-                             QMap<QUrl, qint16> T_EarliestArrivalTime,
-                             QMap<QUrl, QDateTime> S_EarliestArrivalTime,
-                             QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray,
-                             QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > TArray,
                              QObject *parent) : QObject(parent)
 {
     m_pageURI = pageURI;
     QUrlQuery pageQuery = QUrlQuery(m_pageURI.query());
     m_pageTimestamp = QDateTime::fromString(pageQuery.queryItemValue("departureTime"), Qt::ISODate);
     qDebug() << "Page timestamp extracted:" << m_pageTimestamp.toString(Qt::ISODate);
-    m_routes = routes;
-    m_T_EarliestArrivalTime = T_EarliestArrivalTime;
-    m_S_EarliestArrivalTime = S_EarliestArrivalTime;
-    m_SArray = SArray;
-    m_TArray = TArray;
     m_hydraNext = hydraNext;
     m_hydraPrevious = hydraPrevious;
+    m_changes = QVector<QRail::RouterEngine::SnapshotJourney::Change>();
+    m_routes = QList<QSharedPointer<QRail::RouterEngine::Route> >();
+    m_hasRoutes = false;
 }
 
 QUrl SnapshotJourney::pageURI() const
@@ -57,32 +50,79 @@ QUrl SnapshotJourney::hydraNext() const
     return m_hydraNext;
 }
 
+QDateTime SnapshotJourney::pageTimestamp() const
+{
+    return m_pageTimestamp;
+}
+
+const QVector<SnapshotJourney::Change> &SnapshotJourney::changes() const
+{
+    return m_changes;
+}
+
 QList<QSharedPointer<QRail::RouterEngine::Route> > SnapshotJourney::routes() const
 {
     return m_routes;
 }
 
-QMap<QUrl, qint16> SnapshotJourney::T_EarliestArrivalTime() const
+bool SnapshotJourney::hasRoutes() const
 {
-    return m_T_EarliestArrivalTime;
+    return m_hasRoutes;
 }
 
-QMap<QUrl, QDateTime> SnapshotJourney::S_EarliestArrivalTime() const
+void SnapshotJourney::recordT_EarliestArrivalTime(const quint32 tripID, const qint16 count)
 {
-    return m_S_EarliestArrivalTime;
+    SnapshotJourney::Change change;
+    change.type = SnapshotJourney::ChangeType::T_EARLIEST_ARRIVAL_TIME;
+    change.index = tripID;
+    change.time = count;
+    m_changes.append(change);
 }
 
-QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SnapshotJourney::SArray() const
+void SnapshotJourney::recordS_EarliestArrivalTime(const quint32 stationID, const qint64 earliestArrivalTime)
 {
-    return m_SArray;
+    SnapshotJourney::Change change;
+    change.type = SnapshotJourney::ChangeType::S_EARLIEST_ARRIVAL_TIME;
+    change.index = stationID;
+    change.time = earliestArrivalTime;
+    m_changes.append(change);
 }
 
-QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > SnapshotJourney::TArray() const
+void SnapshotJourney::recordTArray(const quint32 tripID, const QSharedPointer<TrainProfile> &trainProfile)
 {
-    return m_TArray;
+    SnapshotJourney::Change change;
+    change.type = SnapshotJourney::ChangeType::T_ARRAY;
+    change.index = tripID;
+    change.time = 0;
+    change.trainProfile = trainProfile;
+    m_changes.append(change);
 }
 
-QDateTime SnapshotJourney::pageTimestamp() const
+void SnapshotJourney::recordSArrayAppend(const quint32 stationID)
 {
-    return m_pageTimestamp;
+    SnapshotJourney::Change change;
+    change.type = SnapshotJourney::ChangeType::S_ARRAY_APPEND;
+    change.index = stationID;
+    change.time = 0;
+    m_changes.append(change);
+}
+
+void SnapshotJourney::recordSArrayReplaceLast(const quint32 stationID, const QSharedPointer<StationStopProfile> &stationStopProfile)
+{
+    SnapshotJourney::Change change;
+    change.type = SnapshotJourney::ChangeType::S_ARRAY_REPLACE_LAST;
+    change.index = stationID;
+    change.time = 0;
+    change.stationStopProfile = stationStopProfile;
+    m_changes.append(change);
+}
+
+void SnapshotJourney::recordRoutes(const QList<QSharedPointer<Route> > &routes)
+{
+    // Only the routes before the page are needed to roll back
+    if (m_hasRoutes) {
+        return;
+    }
+    m_routes = routes;
+    m_hasRoutes = true;
 }
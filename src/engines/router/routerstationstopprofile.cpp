@@ -22,24 +22,21 @@ using namespace QRail;
  * @author Dylan Van Assche
  * @date 09 Aug 2018
  * @brief QRail::RouterEngine::StationStopProfile constructor
- * @param const QDateTime &departureTime
- * @param const QDateTime &arrivalTime
+ * @param const qint64 departureTime
+ * @param const qint64 arrivalTime
  * @param QRail::Fragments::Fragment *departureConnection
  * @param QRail::Fragments::Fragment *arrivalConnection
  * @param const qint16 transfers
- * @param QObject *parent = nullptr
  * @package RouterEngine
  * @public
  * Constructs a QRail::RouterEngine::StationStopProfile for the S array in the Connection Scan Algorithm.
  */
-QRail::RouterEngine::StationStopProfile::StationStopProfile(const QDateTime &departureTime,
-                                                            const QDateTime &arrivalTime,
+QRail::RouterEngine::StationStopProfile::StationStopProfile(const qint64 departureTime,
+                                                            const qint64 arrivalTime,
                                                             QSharedPointer<QRail::Fragments::Fragment> departureConnection,
                                                             QSharedPointer<QRail::Fragments::Fragment> arrivalConnection,
-                                                            const qint16 transfers,
-                                                            QObject *parent) : QObject(parent)
+                                                            const qint16 transfers)
 {
-    // Use private members to avoid signal triggering on construction
     m_departureTime = departureTime;
     m_arrivalTime = arrivalTime;
     m_departureConnection = departureConnection;
@@ -53,11 +50,11 @@ QRail::RouterEngine::StationStopProfile::StationStopProfile(const QDateTime &dep
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Gets the departure time
- * @return QDateTime departureTime
+ * @return qint64 departureTime in seconds since the UNIX epoch
  * @public
  * Gets the departure time in this stop.
  */
-QDateTime QRail::RouterEngine::StationStopProfile::departureTime() const
+qint64 QRail::RouterEngine::StationStopProfile::departureTime() const
 {
     return m_departureTime;
 }
@@ -67,15 +64,14 @@ QDateTime QRail::RouterEngine::StationStopProfile::departureTime() const
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Sets the departure time
- * @param const QDateTime &departureTime
+ * @param const qint64 departureTime
  * @public
- * Sets the current departure time to the given QDateTime &departureTime.
+ * Sets the current departure time to the given qint64 departureTime in seconds since the UNIX epoch.
  * Emits the departureTimeChanged signal when changed.
  */
-void QRail::RouterEngine::StationStopProfile::setDepartureTime(const QDateTime &departureTime)
+void QRail::RouterEngine::StationStopProfile::setDepartureTime(const qint64 departureTime)
 {
     m_departureTime = departureTime;
-    emit this->departureTimeChanged();
 }
 
 /**
@@ -83,11 +79,11 @@ void QRail::RouterEngine::StationStopProfile::setDepartureTime(const QDateTime &
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Gets the arrival time
- * @return QDateTime arrivalTime
+ * @return qint64 arrivalTime in seconds since the UNIX epoch
  * @public
  * Gets the arrival time in this stop.
  */
-QDateTime QRail::RouterEngine::StationStopProfile::arrivalTime() const
+qint64 QRail::RouterEngine::StationStopProfile::arrivalTime() const
 {
     return m_arrivalTime;
 }
@@ -97,15 +93,14 @@ QDateTime QRail::RouterEngine::StationStopProfile::arrivalTime() const
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Sets the arrivelt ime
- * @param const QDateTime &arrivalTime
+ * @param const qint64 arrivalTime
  * @public
- * Sets the current arrival time to the given QDateTime &arrivalTime.
+ * Sets the current arrival time to the given qint64 arrivalTime in seconds since the UNIX epoch.
  * Emits the arrivalTimeChanged signal when changed.
  */
-void QRail::RouterEngine::StationStopProfile::setArrivalTime(const QDateTime &arrivalTime)
+void QRail::RouterEngine::StationStopProfile::setArrivalTime(const qint64 arrivalTime)
 {
     m_arrivalTime = arrivalTime;
-    emit this->arrivalTimeChanged();
 }
 
 /**
@@ -135,7 +130,6 @@ QSharedPointer<QRail::Fragments::Fragment> QRail::RouterEngine::StationStopProfi
 void QRail::RouterEngine::StationStopProfile::setDepartureConnection(QSharedPointer<QRail::Fragments::Fragment> departureConnection)
 {
     m_departureConnection = departureConnection;
-    emit this->departureConnectionChanged();
 }
 
 /**
@@ -165,7 +159,6 @@ QSharedPointer<QRail::Fragments::Fragment> QRail::RouterEngine::StationStopProfi
 void QRail::RouterEngine::StationStopProfile::setArrivalConnection(QSharedPointer<QRail::Fragments::Fragment> arrivalConnection)
 {
     m_arrivalConnection = arrivalConnection;
-    emit this->arrivalConnectionChanged();
 }
 
 /**
@@ -195,5 +188,4 @@ qint16 QRail::RouterEngine::StationStopProfile::transfers() const
 void QRail::RouterEngine::StationStopProfile::setTransfers(const qint16 &transfers)
 {
     m_transfers = transfers;
-    emit this->transfersChanged();
 }
@@ -22,20 +22,17 @@ using namespace QRail;
  * @author Dylan Van Assche
  * @date 09 Aug 2018
  * @brief QRail::RouterEngine::TrainProfile constructor
- * @param const QDateTime &arrivalTime
+ * @param const qint64 arrivalTime
  * @param QRail::Fragments::Fragment *arrivalConnection
  * @param const qint16 transfers
- * @param QObject *parent = nullptr
  * @package RouterEngine
  * @public
  * Constructs a QRail::RouterEngine::TrainProfile for the T array in the Connection Scan Algorithm.
  */
-QRail::RouterEngine::TrainProfile::TrainProfile(const QDateTime &arrivalTime,
+QRail::RouterEngine::TrainProfile::TrainProfile(const qint64 arrivalTime,
                                                 QSharedPointer<QRail::Fragments::Fragment> arrivalConnection,
-                                                const qint16 transfers,
-                                                QObject *parent) : QObject(parent)
+                                                const qint16 transfers)
 {
-    // Use private members to avoid signal trigging on construction
     this->setArrivalTime(arrivalTime);
     this->setArrivalConnection(arrivalConnection);
     this->setTransfers(transfers);
@@ -47,11 +44,11 @@ QRail::RouterEngine::TrainProfile::TrainProfile(const QDateTime &arrivalTime,
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Gets the arrival time
- * @return QDateTime arrivalTime
+ * @return qint64 arrivalTime in seconds since the UNIX epoch
  * @public
  * Gets the arrival time at the final destination.
  */
-QDateTime QRail::RouterEngine::TrainProfile::arrivalTime() const
+qint64 QRail::RouterEngine::TrainProfile::arrivalTime() const
 {
     return m_arrivalTime;
 }
@@ -61,14 +58,13 @@ QDateTime QRail::RouterEngine::TrainProfile::arrivalTime() const
  * @author Dylan Van Assche
  * @date 27 Jul 2018
  * @brief Sets the arrival time
- * @param const QDateTime &arrivalTime
+ * @param const qint64 arrivalTime
  * @public
- * Sets the arrival time at the final destination to the given QDateTime &arrivalTime.
+ * Sets the arrival time at the final destination to the given qint64 arrivalTime in seconds since the UNIX epoch.
  */
-void QRail::RouterEngine::TrainProfile::setArrivalTime(const QDateTime &arrivalTime)
+void QRail::RouterEngine::TrainProfile::setArrivalTime(const qint64 arrivalTime)
 {
     m_arrivalTime = arrivalTime;
-    emit this->arrivalTimeChanged();
 }
 
 /**
@@ -97,7 +93,6 @@ QSharedPointer<QRail::Fragments::Fragment> QRail::RouterEngine::TrainProfile::ar
 void QRail::RouterEngine::TrainProfile::setArrivalConnection(QSharedPointer<QRail::Fragments::Fragment> arrivalConnection)
 {
     m_arrivalConnection = arrivalConnection;
-    emit this->arrivalConnectionChanged();
 }
 
 /**
@@ -126,5 +121,4 @@ qint16 QRail::RouterEngine::TrainProfile::transfers() const
 void QRail::RouterEngine::TrainProfile::setTransfers(const qint16 &transfers)
 {
     m_transfers = transfers;
-    emit this->transfersChanged();
 }
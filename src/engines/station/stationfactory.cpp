@@ -35,7 +35,9 @@ StationEngine::Factory::Factory(QObject *parent) : QObject(parent)
 
 StationEngine::Factory *StationEngine::Factory::getInstance()
 {
-    // Singleton pattern
+    // Singleton pattern, the planners of a RouterEngine::PlannerPool share the instance across threads
+    static QMutex instanceMutex;
+    QMutexLocker locker(&instanceMutex);
     if (m_instance == nullptr) {
         qDebug() << "Generating new StationEngine::Factory";
         m_instance = new StationEngine::Factory();
@@ -780,6 +782,8 @@ bool StationEngine::Factory::insertPlatformIntoDatabase(const QStringList &platf
 // Helpers
 QSharedPointer<StationEngine::Station> StationEngine::Factory::fetchStationFromCache(const QUrl &uri) const
 {
+    // Stations are looked up concurrently by the planners of a RouterEngine::PlannerPool
+    QReadLocker locker(&m_cacheLock);
     if (m_cache.contains(uri)) {
         return this->m_cache.value(uri);
     }
@@ -788,6 +792,11 @@ QSharedPointer<StationEngine::Station> StationEngine::Factory::fetchStationFromC
 
 void StationEngine::Factory::addStationToCache(QSharedPointer<StationEngine::Station> station)
 {
+    if (!station) {
+        return;
+    }
+
+    QWriteLocker locker(&m_cacheLock);
     this->m_cache.insert(station->uri(), station);
 }
 
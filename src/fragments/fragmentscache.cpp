@@ -24,59 +24,52 @@ Cache::Cache(QObject *parent) : QObject(parent)
     QString path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fragments";
 
     // Create the 'fragments' folder to save our caching data
-    QDir m_cacheDir = QDir(path);
+    m_cacheDir = QDir(path);
     m_cacheDir.mkpath(path);
+
+    // Memory tier, pages are evicted to the disk tier when the budget is exceeded
+    m_clockHand = 0;
+    m_cost = 0;
+    m_maxCost = MAX_COST;
+    m_hits = 0;
+    m_diskHits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+
+    // Pages from previous sessions are decoded on demand
+    m_store = new QRail::Fragments::PageStore(m_cacheDir.absolutePath() + PAGE_STORE_FILE_NAME);
+    this->indexDisk();
+
+    // Pages are written in the background, the event loop never waits on the disk
+    m_writerThread = new QThread(this);
+    m_writer = new QRail::Fragments::PageWriter(m_store);
+    m_writer->moveToThread(m_writerThread);
+    m_writerThread->start();
+
+    // Pages which are still queued are written before the application exits
+    if(QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this, SLOT(flush()));
+    }
+}
+
+Cache::~Cache()
+{
+    this->flush();
+    m_writerThread->quit();
+    m_writerThread->wait();
+    delete m_writer;
+    delete m_store;
 }
 
 void Cache::cachePage(QSharedPointer<QRail::Fragments::Page> page)
 {
     // Add the page to the LRU cache and return true if success
     qDebug() << "Inserted page:" << page->uri();
-    m_cache.insert(page->uri(), page);
+    this->insertPage(page);
     qDebug() << "Number of entries in cache:" << m_cache.count();
 
-    // Cache the page on disk
-    QJsonObject obj;
-    obj.insert("uri", QJsonValue::fromVariant(page->uri().toString()));
-    obj.insert("timestamp", QJsonValue::fromVariant(page->timestamp().toString(Qt::ISODate)));
-    obj.insert("hydraPrevious", QJsonValue::fromVariant(page->hydraPrevious()).toString());
-    obj.insert("hydraNext", QJsonValue::fromVariant(page->hydraNext().toString()));
-    QJsonArray fragments;
-    qDebug() << "Fragments:";
-    qDebug() << page->fragments();
-    foreach(QSharedPointer<QRail::Fragments::Fragment> frag, page->fragments()) {
-        QJsonObject f;
-        f.insert("uri", QJsonValue::fromVariant(frag->uri().toString()));
-        f.insert("departureStationURI", QJsonValue::fromVariant(frag->departureStationURI().toString()));
-        f.insert("arrivalStationURI", QJsonValue::fromVariant(frag->arrivalStationURI().toString()));
-        f.insert("departureTime", QJsonValue::fromVariant(frag->departureTime().toString(Qt::ISODate)));
-        f.insert("arrivalTime", QJsonValue::fromVariant(frag->arrivalTime().toString(Qt::ISODate)));
-        f.insert("departureDelay", QJsonValue::fromVariant(frag->departureDelay()));
-        f.insert("arrivalDelay", QJsonValue::fromVariant(frag->arrivalDelay()));
-        f.insert("tripURI", QJsonValue::fromVariant(frag->tripURI().toString()));
-        f.insert("routeURI", QJsonValue::fromVariant(frag->routeURI().toString()));
-        f.insert("direction", QJsonValue::fromVariant(frag->direction()));
-        f.insert("pickupType", this->convertGTFSTypeToJson(frag->pickupType()));
-        f.insert("dropOffType", this->convertGTFSTypeToJson(frag->dropOffType()));
-        fragments.append(f);
-    }
-    obj.insert("fragments", fragments);
-    QJsonDocument doc = QJsonDocument(obj);
-    qDebug() << "Fragment updated";
-
-    // Save QJsonDocument to disk
-    QString path = m_cacheDir.absolutePath();
-    path.append("/" + page->uri().toString());
-    QDir jsonFileDir(path);
-    jsonFileDir.mkpath(path);
-    qDebug() << "Fragment opened as:" << path;
-
-    path.append(PAGE_FILE_NAME);
-    QFile jsonFile(path);
-    jsonFile.open(QFile::WriteOnly);
-    jsonFile.write(doc.toJson());
-    jsonFile.close();
-    qDebug() << "Fragment written as:" << path;
+    // Cache the page on disk, repeated updates of a page are written once
+    m_writer->enqueue(page);
 }
 
 QUrl Cache::updateFragment(QSharedPointer<QRail::Fragments::Fragment> updatedFragment)
@@ -85,100 +78,76 @@ QUrl Cache::updateFragment(QSharedPointer<QRail::Fragments::Fragment> updatedFra
     // We look between the departureTime and departureTime + departureDelay for the old fragment
     QDateTime departureTime = updatedFragment->departureTime().addSecs(-updatedFragment->departureDelay());
     QDateTime departureTimeWithDelay = updatedFragment->departureTime();
-    QList<QUrl> pagesURI = m_cache.keys();
-    QUrl updatedPageURI;
-
-    for(qint64 pageCounter=0; pageCounter < pagesURI.length(); pageCounter++) {
-        QUrl pageURI = pagesURI[pageCounter];
-        QUrlQuery query = QUrlQuery(pageURI);
-        QDateTime pageTime = QDateTime::fromString(query.queryItemValue("departureTime"), Qt::ISODate);
-        if(pageTime <= departureTimeWithDelay) { // just the page before the departure time must be considered too! This can be optimized...
-            //qDebug() << "PAGE TIME:" << pageTime << "| DEP:" << departureTime << "| DEP+DEL:" << departureTimeWithDelay;
-            QSharedPointer<QRail::Fragments::Page> page = m_cache.value(pageURI);
-            QList<QSharedPointer<QRail::Fragments::Fragment>> fragments = page->fragments();
-
-            // Check if the connection is in the fragments of this page
-            for(qint32 fragCounter=0; fragCounter < fragments.length(); fragCounter++) {
-                QSharedPointer<QRail::Fragments::Fragment> fragment = fragments.at(fragCounter);
-
-                // Check if this fragment is the one we're looking for
-                if(fragment->uri() == updatedFragment->uri()) {
-                    //qDebug() << "Found fragment!";
-
-                    // Departure delay changed, removing old fragment and inserting new fragment
-                    if(fragment->departureDelay() != updatedFragment->departureDelay()) {
-                        qDebug() << "Deleting old fragment, inserting new one";
-                        // Remove old fragment in the old page
-                        qDebug() << "----------PAGE HAS BEFORE:" << page->fragments().count() << " FRAGMENTS";
-                        QList<QSharedPointer<QRail::Fragments::Fragment>> pageFrags = page->fragments();
-                        QSharedPointer<QRail::Fragments::Fragment> frag = pageFrags.at(fragCounter);
-                        pageFrags.removeAt(fragCounter);
-                        page->setFragments(pageFrags);
-                        updatedPageURI = page->uri();
-                        qDebug() << "Departure delay update";
-                        qDebug() << "----------PAGE HAS NOW:" << page->fragments().count() << " FRAGMENTS";
-                        this->cachePage(page);
-
-                        // Insert updated fragment in the new page
-                        qDebug() << "Inserting updated fragment in other page...";
-                        for(qint32 pageCounter=0; pageCounter < pagesURI.length() - 1; pageCounter++) {
-                            QUrl currentPageURI = pagesURI.at(pageCounter);
-                            QUrl nextPageURI = pagesURI.at(pageCounter + 1);
-                            QUrlQuery currentPageQuery = QUrlQuery(currentPageURI);
-                            QUrlQuery nextPageQuery = QUrlQuery(nextPageURI);
-                            QDateTime currentPageTime = QDateTime::fromString(currentPageQuery.queryItemValue("departureTime"), Qt::ISODate);
-                            QDateTime nextPageTime = QDateTime::fromString(nextPageQuery.queryItemValue("departureTime"), Qt::ISODate);
-                            qDebug() << currentPageTime << "<=" << departureTime << "<" << nextPageTime;
-
-                            // Look for the new page
-                            if(currentPageTime <= departureTime && departureTime < nextPageTime) {
-                                qDebug() << "Found inserting page, inserting fragment now";
-                                QSharedPointer<QRail::Fragments::Page> currentPage = m_cache.value(currentPageURI);
-                                qDebug() << "----------CURRENT PAGE HAS BEFORE:" << currentPage->fragments().count() << " FRAGMENTS";
-                                QList<QSharedPointer<QRail::Fragments::Fragment>> currentPageFrags = currentPage->fragments();
-                                currentPageFrags.append(updatedFragment);
-
-                                // Keep page sorted
-                                std::sort(currentPageFrags.begin(), currentPageFrags.end(), [](const QSharedPointer<QRail::Fragments::Fragment> a,
-                                const QSharedPointer<QRail::Fragments::Fragment> b) -> bool {
-                                    QDateTime timeA = a->departureTime();
-                                    QDateTime timeB = b->departureTime();
-                                    return timeA < timeB;
-                                });
-                                qDebug() << "Sorting OK";
-
-                                currentPage->setFragments(currentPageFrags);
-                                qDebug() << "Inserted into page";
-                                qDebug() << "----------CURRENT PAGE HAS NOW:" << currentPage->fragments().count() << " FRAGMENTS";
-
-                                this->cachePage(currentPage);
-                                qDebug() << "Caching OK";
-                                break;
-                            }
-                        }
-
-                        // Update completed
-                        return updatedPageURI;
-                    }
-
-                    // Arrival delay changed or cancelled (type changed), updating fragment in page
-                    if(fragment->arrivalDelay() != updatedFragment->arrivalDelay()) {
-                        qDebug() << "Updating old fragment";
-                        QList<QSharedPointer<QRail::Fragments::Fragment>> pageFrags = page->fragments();
-                        QSharedPointer<QRail::Fragments::Fragment> frag = pageFrags.at(fragCounter);
-                        pageFrags.replace(fragCounter, updatedFragment);
-                        updatedPageURI = page->uri();                     
-                        qDebug() << "Arrival delay update";
-                        page->setFragments(pageFrags);
-                        qDebug() << "fragments=" << page->fragments();
-                        this->cachePage(page);
-
-                        // Update completed
-                        return updatedPageURI;
-                    }
-                }
+    if(departureTimeWithDelay < departureTime) {
+        departureTimeWithDelay = departureTime;
+    }
+
+    // Only the pages covering that window are scanned, evicted pages are loaded from disk
+    QSharedPointer<QRail::Fragments::Page> page;
+    qint32 position = -1;
+    foreach(QSharedPointer<QRail::Fragments::Page> candidate, this->getPagesBetween(departureTime, departureTimeWithDelay.addSecs(1))) {
+        QList<QSharedPointer<QRail::Fragments::Fragment>> candidateFrags = candidate->fragments();
+        for(qint32 fragCounter = 0; fragCounter < candidateFrags.size(); fragCounter++) {
+            if(candidateFrags.at(fragCounter)->uri() == updatedFragment->uri()) {
+                page = candidate;
+                position = fragCounter;
+                break;
             }
         }
+        if(page) {
+            break;
+        }
+    }
+
+    // Only connections of cached pages can be updated
+    if(!page) {
+        return QUrl();
+    }
+
+    QList<QSharedPointer<QRail::Fragments::Fragment>> pageFrags = page->fragments();
+    QSharedPointer<QRail::Fragments::Fragment> fragment = pageFrags.at(position);
+
+    /*
+     * Pages are shared read-only with the planners, which may scan them in other threads.
+     * An update never modifies a page, a copy with the updated fragments replaces it in the cache.
+     */
+
+    // Departure delay changed, removing old fragment and inserting new fragment
+    if(fragment->departureDelay() != updatedFragment->departureDelay()) {
+        qDebug() << "Deleting old fragment, inserting new one";
+        pageFrags.removeAt(position);
+        qDebug() << "Departure delay update";
+        this->cachePage(this->copyPage(page, pageFrags));
+
+        // Insert the fragment in the page which covers its new departure time
+        QSharedPointer<QRail::Fragments::Page> currentPage = this->getPageByTime(updatedFragment->departureTime());
+        if(currentPage) {
+            QList<QSharedPointer<QRail::Fragments::Fragment>> currentPageFrags = currentPage->fragments();
+
+            // Keep page sorted
+            QList<QSharedPointer<QRail::Fragments::Fragment>>::iterator position = std::upper_bound(currentPageFrags.begin(), currentPageFrags.end(), updatedFragment, [](
+                    const QSharedPointer<QRail::Fragments::Fragment> a,
+                    const QSharedPointer<QRail::Fragments::Fragment> b) -> bool {
+                return a->departureTime() < b->departureTime();
+            });
+            currentPageFrags.insert(position, updatedFragment);
+            qDebug() << "Inserted into page" << currentPage->uri();
+            this->cachePage(this->copyPage(currentPage, currentPageFrags));
+        }
+
+        // Update completed
+        return page->uri();
+    }
+
+    // Arrival delay changed or cancelled (type changed), updating fragment in page
+    if(fragment->arrivalDelay() != updatedFragment->arrivalDelay()) {
+        qDebug() << "Updating old fragment";
+        pageFrags.replace(position, updatedFragment);
+        qDebug() << "Arrival delay update";
+        this->cachePage(this->copyPage(page, pageFrags));
+
+        // Update completed
+        return page->uri();
     }
 
     return QUrl();
@@ -186,33 +155,16 @@ QUrl Cache::updateFragment(QSharedPointer<QRail::Fragments::Fragment> updatedFra
 
 QSharedPointer<QRail::Fragments::Page> Cache::getPageByURI(QUrl uri)
 {
-    // Try to get the page from the RAM cache
-    if(m_cache.contains(uri)) {
-        //qDebug() << "Memory cache" << m_cache.value(uri);
-        return m_cache.value(uri);
-    }
-
     // If the requested page isn't cached, the Fragments::Factory will fetch it from the network
-    return this->getPageFromDisk(uri);
+    return this->lookupPage(uri);
 }
 
 QSharedPointer<QRail::Fragments::Page> Cache::getPageByFragment(QSharedPointer<QRail::Fragments::Fragment> fragment)
 {
-    // If our fragment is already later than our last page or before our first page, don't even bother to search for the page.
-    if(m_cache.count() > 0) {
-        if(fragment->departureTime() > m_cache.last()->timestamp() || fragment->departureTime() < m_cache.first()->timestamp()) {
-            return nullptr;
-        }
-    }
-
-    foreach(QSharedPointer<QRail::Fragments::Page> page, m_cache.values()) {
-        //qDebug() << "Fragment < page: " << fragment->departureTime() << "|" << page->timestamp();
-        if(fragment->departureTime() < page->timestamp()) {
-            continue;
-        }
-        else {
-            return page;
-        }
+    // The page which covers the departure time of the fragment
+    QSharedPointer<QRail::Fragments::Page> page = this->getPageByTime(fragment->departureTime());
+    if(page) {
+        return page;
     }
 
     // In case we can't find a page (page hasn't been downloaded yet)
@@ -220,11 +172,119 @@ QSharedPointer<QRail::Fragments::Page> Cache::getPageByFragment(QSharedPointer<Q
     return nullptr;
 }
 
+QSharedPointer<QRail::Fragments::Page> Cache::getPageByTime(const QDateTime &time)
+{
+    // The last page starting at or before the given time
+    QMap<QDateTime, QRail::Fragments::Cache::PageInterval>::const_iterator it = m_pageIndex.upperBound(time);
+    if(it == m_pageIndex.constBegin()) {
+        m_misses++;
+        return nullptr;
+    }
+    --it;
+
+    // The time falls in a gap between the cached pages
+    if(it.value().end.isValid() && time >= it.value().end) {
+        m_misses++;
+        return nullptr;
+    }
+
+    // Pages which are only known on disk are decoded from the page store
+    QSharedPointer<QRail::Fragments::Page> page = this->lookupPage(it.value().uri);
+    if(!page) {
+        m_pageIndex.remove(it.key());
+    }
+    return page;
+}
+
+QList<QSharedPointer<QRail::Fragments::Page>> Cache::getPagesBetween(const QDateTime &from, const QDateTime &until)
+{
+    // Pages in ASCENDING time order which overlap [from, until)
+    QList<QSharedPointer<QRail::Fragments::Page>> pages;
+    QMap<QDateTime, QRail::Fragments::Cache::PageInterval>::const_iterator it = m_pageIndex.upperBound(from);
+    if(it != m_pageIndex.constBegin()) {
+        --it;
+        if(it.value().end.isValid() && from >= it.value().end) {
+            ++it;
+        }
+    }
+
+    // Pages which are only known on disk are loaded too
+    QList<QUrl> uris;
+    for(; it != m_pageIndex.constEnd() && it.key() < until; ++it) {
+        uris.append(it.value().uri);
+    }
+    foreach(QUrl uri, uris) {
+        QSharedPointer<QRail::Fragments::Page> page = this->getPageByURI(uri);
+        if(page) {
+            pages.append(page);
+        }
+    }
+    return pages;
+}
+
 bool Cache::hasPage(QUrl uri)
 {
     return m_cache.contains(uri);
 }
 
+void Cache::flush()
+{
+    m_writer->flush();
+}
+
+void Cache::pinPages(const QList<QUrl> &uris)
+{
+    foreach(QUrl uri, uris) {
+        m_pins[uri]++;
+    }
+}
+
+void Cache::unpinPages(const QList<QUrl> &uris)
+{
+    foreach(QUrl uri, uris) {
+        if(--m_pins[uri] <= 0) {
+            m_pins.remove(uri);
+        }
+    }
+    this->evictPages();
+}
+
+qint64 Cache::cost() const
+{
+    return m_cost;
+}
+
+qint64 Cache::maxCost() const
+{
+    return m_maxCost;
+}
+
+void Cache::setMaxCost(const qint64 maxCost)
+{
+    m_maxCost = maxCost;
+    this->evictPages();
+}
+
+quint64 Cache::hits() const
+{
+    return m_hits;
+}
+
+quint64 Cache::diskHits() const
+{
+    return m_diskHits;
+}
+
+quint64 Cache::misses() const
+{
+    return m_misses;
+}
+
+quint64 Cache::evictions() const
+{
+    return m_evictions;
+}
+
 bool Cache::isEmpty()
 {
     return m_cache.count() == 0;
@@ -233,94 +293,149 @@ bool Cache::isEmpty()
 QSharedPointer<QRail::Fragments::Page> Cache::getPageFromDisk(QUrl uri)
 {
     // The page can be available on disk, but not in the RAM cache
-    QString path = m_cacheDir.absolutePath();
-    path.append("/" + uri.toString());
-    path.append(PAGE_FILE_NAME);
-    //qDebug() << "PAGE file path:" << path;
-
-    if(QFileInfo::exists(path)) {
-        // Read page from disk
-        //qDebug() << "Page found in disk cache";
-        QFile jsonFile;
-        jsonFile.setFileName(path);
-        jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
-        QString data = jsonFile.readAll();
-        jsonFile.close();
-        QJsonDocument d = QJsonDocument::fromJson(data.toUtf8());
-        QJsonObject obj = d.object();
-
-        // Convert QJsonObject to QRail::Fragments::Page *
-        QSharedPointer<QRail::Fragments::Page> page = QSharedPointer<QRail::Fragments::Page>(new QRail::Fragments::Page());
-        page->setURI(QUrl(obj["uri"].toString()));
-        page->setHydraNext(QUrl(obj["hydraNext"].toString()));
-        page->setHydraPrevious(QUrl(obj["hydraPrevious"].toString()));
-        page->setTimestamp(QDateTime::fromString(obj["timestamp"].toString(), Qt::ISODate));
-        QJsonArray fragmentsJson = obj["fragments"].toArray();
-        QList<QSharedPointer<QRail::Fragments::Fragment>> fragments;
-        foreach(QJsonValue item, fragmentsJson) {
-            QJsonObject frag = item.toObject();
-            QSharedPointer<QRail::Fragments::Fragment> fragment = QSharedPointer<QRail::Fragments::Fragment>(new QRail::Fragments::Fragment());
-            fragment->setURI(QUrl(frag["uri"].toString()));
-            fragment->setDepartureStationURI(QUrl(frag["departureStationURI"].toString()));
-            fragment->setArrivalStationURI(QUrl(frag["arrivalStationURI"].toString()));
-            fragment->setDepartureTime(QDateTime::fromString(frag["departureTime"].toString(), Qt::ISODate));
-            fragment->setArrivalTime(QDateTime::fromString(frag["arrivalTime"].toString(), Qt::ISODate));
-            fragment->setDepartureDelay(frag["departureDelay"].toInt());
-            fragment->setArrivalDelay(frag["arrivalDelay"].toInt());
-            fragment->setTripURI(QUrl(frag["tripURI"].toString()));
-            fragment->setRouteURI(QUrl(frag["routeURI"].toString()));
-            fragment->setDirection(frag["direction"].toString());
-            fragment->setPickupType(this->convertJsonToGTFSType(frag["pickupType"]));
-            fragment->setDropOffType(this->convertJsonToGTFSType(frag["dropOffType"]));
-
-            // Add fragment to list
-            fragments.append(fragment);
-        }
-        page->setFragments(fragments);
-
+    QSharedPointer<QRail::Fragments::Page> page = m_writer->pendingPage(uri);
+    if(!page) {
+        page = m_store->read(uri);
+    }
+    if(page) {
         // Insert page in memory cache and return it
-        m_cache.insert(page->uri(), page);
+        m_diskHits++;
+        this->insertPage(page);
         return page;
     }
 
     // No page available, return NULL pointer
     qWarning() << "Cannot find page in disk cache";
+    m_misses++;
     return nullptr;
 }
 
-QJsonValue Cache::convertGTFSTypeToJson(Fragment::GTFSTypes type)
+void Cache::insertPage(QSharedPointer<Page> page)
 {
-    if(type == Fragment::GTFSTypes::REGULAR) {
-        return QJsonValue::fromVariant(QString("gtfs:Regular"));
+    m_cache.insert(page->uri(), page);
+
+    // New pages are placed right behind the CLOCK hand, the hand reaches them last
+    QRail::Fragments::Cache::CacheEntry entry;
+    entry.cost = this->pageCost(page);
+    entry.referenced = true;
+    if(m_entries.contains(page->uri())) {
+        m_cost -= m_entries.value(page->uri()).cost;
     }
-    else if(type == Fragment::GTFSTypes::NOTAVAILABLE) {
-        return QJsonValue::fromVariant(QString("gtfs:NotAvailable"));
+    else {
+        m_clock.insert(m_clockHand, page->uri());
+        m_clockHand++;
     }
-    else if(type == Fragment::GTFSTypes::MUSTPHONE) {
-        return QJsonValue::fromVariant(QString("gtfs:MustPhone"));
+    m_entries.insert(page->uri(), entry);
+    m_cost += entry.cost;
+
+    // Pages without a departure time in their URI start at their first connection
+    QRail::Fragments::Cache::PageInterval interval;
+    interval.uri = page->uri();
+    interval.start = this->pageTime(page->uri());
+    interval.end = this->pageTime(page->hydraNext());
+    if(!interval.start.isValid() && page->fragments().size() > 0) {
+        interval.start = page->fragments().first()->departureTime();
     }
-    else if(type == Fragment::GTFSTypes::MUSTCOORDINATEWITHDRIVER) {
-        return QJsonValue::fromVariant(QString("gtfs:MustCoordinateWithDriver"));
+    if(interval.start.isValid()) {
+        m_pageIndex.insert(interval.start, interval);
     }
 
-    return QJsonValue::fromVariant(QString("gtfs:Unknown"));
+    this->evictPages();
 }
 
-Fragment::GTFSTypes Cache::convertJsonToGTFSType(QJsonValue type)
+QSharedPointer<QRail::Fragments::Page> Cache::copyPage(QSharedPointer<QRail::Fragments::Page> page,
+                                                       const QList<QSharedPointer<QRail::Fragments::Fragment>> &fragments) const
 {
-    QString t = type.toString();
-    if(t == QString("gtfs:Regular")) {
-        return QRail::Fragments::Fragment::GTFSTypes::REGULAR;
+    QSharedPointer<QRail::Fragments::Page> copy = QSharedPointer<QRail::Fragments::Page>(new QRail::Fragments::Page(page->uri(),
+                                                                                                                    page->timestamp(),
+                                                                                                                    page->hydraNext(),
+                                                                                                                    page->hydraPrevious(),
+                                                                                                                    fragments));
+
+    // The fragments are shared with the old page, the Page doesn't take ownership of them
+    return copy;
+}
+
+QSharedPointer<QRail::Fragments::Page> Cache::lookupPage(const QUrl &uri)
+{
+    // Try to get the page from the RAM cache
+    QMap<QUrl, QSharedPointer<QRail::Fragments::Page>>::const_iterator it = m_cache.constFind(uri);
+    if(it != m_cache.constEnd()) {
+        m_entries[uri].referenced = true;
+        m_hits++;
+        return it.value();
     }
-    else if(t == QString("gtfs:NotAvailable")) {
-        return QRail::Fragments::Fragment::GTFSTypes::NOTAVAILABLE;
+
+    return this->getPageFromDisk(uri);
+}
+
+void Cache::evictPages()
+{
+    // CLOCK eviction, a page survives one pass of the hand after it has been used
+    qint32 skipped = 0;
+    while(m_cost > m_maxCost && skipped < 2 * m_clock.size()) {
+        if(m_clockHand >= m_clock.size()) {
+            m_clockHand = 0;
+        }
+
+        QUrl uri = m_clock.at(m_clockHand);
+        QRail::Fragments::Cache::CacheEntry &entry = m_entries[uri];
+        if(m_pins.contains(uri) || entry.referenced) {
+            entry.referenced = false;
+            m_clockHand++;
+            skipped++;
+            continue;
+        }
+
+        // Evicted pages remain available from the disk tier through the page index
+        qDebug() << "Evicting page:" << uri;
+        m_cost -= entry.cost;
+        m_entries.remove(uri);
+        m_cache.remove(uri);
+        m_clock.removeAt(m_clockHand);
+        m_evictions++;
+        skipped = 0;
     }
-    else if(t == QString("gtfs:MustPhone")) {
-        return QRail::Fragments::Fragment::GTFSTypes::MUSTPHONE;
+}
+
+qint64 Cache::pageCost(QSharedPointer<QRail::Fragments::Page> page) const
+{
+    // Objects and their URIs, QString stores 2 bytes per character
+    qint64 cost = sizeof(QRail::Fragments::Page) + 2 * (page->uri().toString().size()
+                                                         + page->hydraNext().toString().size()
+                                                         + page->hydraPrevious().toString().size());
+    foreach(QSharedPointer<QRail::Fragments::Fragment> fragment, page->fragments()) {
+        cost += sizeof(QRail::Fragments::Fragment)
+                + 2 * (fragment->uri().toString().size()
+                       + fragment->departureStationURI().toString().size()
+                       + fragment->arrivalStationURI().toString().size()
+                       + fragment->tripURI().toString().size()
+                       + fragment->routeURI().toString().size()
+                       + fragment->direction().size());
     }
-    else if(t == QString("gtfs:MustCoordinateWithDriver")) {
-        return QRail::Fragments::Fragment::GTFSTypes::MUSTCOORDINATEWITHDRIVER;
+    return cost;
+}
+
+void Cache::indexDisk()
+{
+    // The record headers of the page store are enough to know which interval a page covers
+    foreach(QRail::Fragments::PageStore::Entry entry, m_store->entries()) {
+        QRail::Fragments::Cache::PageInterval interval;
+        interval.uri = entry.uri;
+        interval.start = this->pageTime(entry.uri);
+        interval.end = this->pageTime(entry.hydraNext);
+        if(!interval.start.isValid()) {
+            interval.start = entry.firstDepartureTime;
+        }
+        if(interval.start.isValid() && !m_pageIndex.contains(interval.start)) {
+            m_pageIndex.insert(interval.start, interval);
+        }
     }
+    qDebug() << "Pages available in disk cache:" << m_pageIndex.size();
+}
 
-    return QRail::Fragments::Fragment::GTFSTypes::UNKNOWN;
+QDateTime Cache::pageTime(const QUrl &uri) const
+{
+    QUrlQuery query = QUrlQuery(uri);
+    return QDateTime::fromString(query.queryItemValue("departureTime"), Qt::ISODate);
 }
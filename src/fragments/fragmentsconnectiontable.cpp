@@ -0,0 +1,88 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragments/fragmentsconnectiontable.h"
+using namespace QRail;
+
+QRail::Fragments::ConnectionTable::ConnectionTable(const QList<QSharedPointer<QRail::Fragments::Fragment> > &fragments)
+{
+    qint32 size = fragments.size();
+    m_departureStationIDs.reserve(size);
+    m_arrivalStationIDs.reserve(size);
+    m_tripIDs.reserve(size);
+    m_departureTimes.reserve(size);
+    m_arrivalTimes.reserve(size);
+    m_pickupTypes.reserve(size);
+    m_dropOffTypes.reserve(size);
+    m_fragments.reserve(size);
+
+    foreach (QSharedPointer<QRail::Fragments::Fragment> fragment, fragments) {
+        m_departureStationIDs.append(fragment->departureStationID());
+        m_arrivalStationIDs.append(fragment->arrivalStationID());
+        m_tripIDs.append(fragment->tripID());
+        // QDateTime::toSecsSinceEpoch() requires Qt 5.8
+        m_departureTimes.append(fragment->departureTime().toMSecsSinceEpoch() / 1000);
+        m_arrivalTimes.append(fragment->arrivalTime().toMSecsSinceEpoch() / 1000);
+        m_pickupTypes.append(static_cast<quint8>(fragment->pickupType()));
+        m_dropOffTypes.append(static_cast<quint8>(fragment->dropOffType()));
+        m_fragments.append(fragment);
+    }
+}
+
+qint32 QRail::Fragments::ConnectionTable::size() const
+{
+    return m_fragments.size();
+}
+
+const QVector<quint32> &QRail::Fragments::ConnectionTable::departureStationIDs() const
+{
+    return m_departureStationIDs;
+}
+
+const QVector<quint32> &QRail::Fragments::ConnectionTable::arrivalStationIDs() const
+{
+    return m_arrivalStationIDs;
+}
+
+const QVector<quint32> &QRail::Fragments::ConnectionTable::tripIDs() const
+{
+    return m_tripIDs;
+}
+
+const QVector<qint64> &QRail::Fragments::ConnectionTable::departureTimes() const
+{
+    return m_departureTimes;
+}
+
+const QVector<qint64> &QRail::Fragments::ConnectionTable::arrivalTimes() const
+{
+    return m_arrivalTimes;
+}
+
+const QVector<quint8> &QRail::Fragments::ConnectionTable::pickupTypes() const
+{
+    return m_pickupTypes;
+}
+
+const QVector<quint8> &QRail::Fragments::ConnectionTable::dropOffTypes() const
+{
+    return m_dropOffTypes;
+}
+
+QSharedPointer<QRail::Fragments::Fragment> QRail::Fragments::ConnectionTable::fragment(const qint32 row) const
+{
+    return m_fragments.at(row);
+}
@@ -22,6 +22,7 @@ QRail::Fragments::Factory::Factory(QRail::Network::EventSource::Subscription sub
 {
     // Setup the QRail::Network::Manager
     m_http = QRail::Network::Manager::getInstance();
+    m_updateVersion = 0;
 
     /*
      * QNAM and callers are living in different threads!
@@ -72,25 +73,57 @@ QRail::Fragments::Factory *QRail::Fragments::Factory::getInstance(QRail::Network
 }
 
 // Invokers
-void QRail::Fragments::Factory::getPage(const QUrl &uri)
+void QRail::Fragments::Factory::getPage(const QUrl &uri, QObject *caller, const quint64 requestID)
 {
-    // Page is cached, dispatching!
+    // Page is cached, dispatching! Updates are only applied to the cached page, the prefetched copy is outdated then.
     qDebug() << "Requesting page from cache...";
     QSharedPointer<QRail::Fragments::Page> page = this->pageCache()->getPageByURI(uri);
     if(page && m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
         //this->dispatcher()->dispatchPage(page);
         qDebug() << "Page retrieved from cache:" << uri;
+        m_prefetchedPages.remove(uri);
+        m_prefetchedOrder.removeOne(uri);
         emit this->pageReady(page);
+        emit this->pageDispatched(page, caller, requestID);
+        return;
+    }
+
+    // Page has been prefetched, dispatching!
+    if (m_prefetchedPages.contains(uri)) {
+        page = m_prefetchedPages.take(uri);
+        m_prefetchedOrder.removeOne(uri);
+        qDebug() << "Page retrieved from prefetched pages:" << uri;
+        emit this->pageReady(page);
+        emit this->pageDispatched(page, caller, requestID);
+        return;
+    }
+
+    // Page is already in flight, dispatch it to this caller too when it arrives
+    if (m_inFlight.contains(uri)) {
+        qDebug() << "Page already requested, waiting for it:" << uri;
+        QRail::Fragments::Factory::Caller waitingCaller;
+        waitingCaller.caller = caller;
+        waitingCaller.requestID = requestID;
+        m_requests[m_inFlight.value(uri)].callers.append(waitingCaller);
         return;
     }
 
     // Page is not in cache
     qDebug() << "Retrieving page from server...:" << uri;
-    this->getPageByURIFromNetworkManager(uri);
+    this->getPageByURIFromNetworkManager(uri, caller, requestID, 0, QRail::Fragments::Factory::Direction::PREVIOUS);
 }
 
-void QRail::Fragments::Factory::getPage(const QDateTime &departureTime)
+void QRail::Fragments::Factory::getPage(const QDateTime &departureTime, QObject *caller, const quint64 requestID)
 {
+    // Page URIs are canonicalized by the server, look up the cached page which covers this time instead
+    if (m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
+        QSharedPointer<QRail::Fragments::Page> page = this->pageCache()->getPageByTime(departureTime);
+        if (page) {
+            this->getPage(page->uri(), caller, requestID);
+            return;
+        }
+    }
+
     // Construct the URI of the page
     QUrl uri = QUrl(BASE_URL);
     QUrlQuery parameters;
@@ -101,19 +134,39 @@ void QRail::Fragments::Factory::getPage(const QDateTime &departureTime)
     //this->dispatcher()->addTarget(departureTime.toUTC(), caller);
     //qDebug() << "Dispatcher added target:" << departureTime.toUTC() << caller;
 
-    // Page is cached, dispatching!
-    qDebug() << "Requesting page from cache...";
-    QSharedPointer<QRail::Fragments::Page> page = this->pageCache()->getPageByURI(uri);
-    if(page && m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
-        //this->dispatcher()->dispatchPage(page);
-        qDebug() << "Page retrieved from cache:" << uri;
-        emit this->pageReady(page);
+    // Fetch the page by its URI
+    this->getPage(uri, caller, requestID);
+}
+
+void QRail::Fragments::Factory::prefetchPages(const QUrl &uri, const quint16 depth, QRail::Fragments::Factory::Direction direction)
+{
+    if (depth == 0 || !uri.isValid()) {
         return;
     }
 
-    // Page is not in cache
-    qDebug() << "Retrieving page from server...:" << uri;
-    this->getPageByURIFromNetworkManager(uri);
+    // Already in flight, make sure the chain continues deep enough
+    if (m_inFlight.contains(uri)) {
+        QRail::Fragments::Factory::Request &request = m_requests[m_inFlight.value(uri)];
+        if (request.prefetchDepth < depth - 1) {
+            request.prefetchDepth = depth - 1;
+            request.direction = direction;
+        }
+        return;
+    }
+
+    // Already available, continue the chain from this page
+    QSharedPointer<QRail::Fragments::Page> page = m_prefetchedPages.value(uri);
+    if (!page && m_subscriptionType != QRail::Network::EventSource::Subscription::NONE) {
+        page = this->pageCache()->getPageByURI(uri);
+    }
+    if (page) {
+        this->prefetchPages(direction == QRail::Fragments::Factory::Direction::PREVIOUS ? page->hydraPrevious() : page->hydraNext(),
+                            depth - 1, direction);
+        return;
+    }
+
+    qDebug() << "Prefetching page:" << uri << "depth:" << depth;
+    this->getPageByURIFromNetworkManager(uri, nullptr, 0, depth - 1, direction);
 }
 
 void Fragments::Factory::handleEventSource(QString message)
@@ -139,6 +192,12 @@ void Fragments::Factory::handleEventSource(QString message)
                 qDebug() << "Updated page URI:" << updatedPageURI;
 
                 if(updatedPageURI.isValid()) {
+                    // The prefetched copy doesn't contain the update
+                    m_prefetchedPages.remove(updatedPageURI);
+                    m_prefetchedOrder.removeOne(updatedPageURI);
+                    m_cache_mutex.lock();
+                    m_updateVersion++;
+                    m_cache_mutex.unlock();
                     emit this->pageUpdated(updatedPageURI);
                     emit this->fragmentUpdated(frag);
                     emit this->fragmentAndPageUpdated(frag, updatedPageURI);
@@ -157,6 +216,12 @@ void Fragments::Factory::handleEventSource(QString message)
     emit this->updateProcessed(QDateTime::currentMSecsSinceEpoch());
 }
 
+quint64 QRail::Fragments::Factory::updateVersion() const
+{
+    QMutexLocker lock(&m_cache_mutex);
+    return m_updateVersion;
+}
+
 QRail::Fragments::Cache* QRail::Fragments::Factory::pageCache() const
 {
     QMutexLocker lock(&m_cache_mutex);
@@ -193,13 +258,39 @@ Fragments::Fragment::GTFSTypes Fragments::Factory::parseGTFSType(QString type)
 }
 
 // Processors
-void QRail::Fragments::Factory::getPageByURIFromNetworkManager(const QUrl &uri)
+void QRail::Fragments::Factory::addPrefetchedPage(const QUrl &uri, QSharedPointer<QRail::Fragments::Page> page)
+{
+    // Drop the oldest prefetched pages when nobody consumed them
+    while (m_prefetchedOrder.size() >= PREFETCH_MAX_PAGES) {
+        m_prefetchedPages.remove(m_prefetchedOrder.takeFirst());
+    }
+    m_prefetchedPages.insert(uri, page);
+    m_prefetchedOrder.append(uri);
+}
+
+void QRail::Fragments::Factory::getPageByURIFromNetworkManager(const QUrl &uri,
+                                                                QObject *caller,
+                                                                const quint64 requestID,
+                                                                const quint16 prefetchDepth,
+                                                                QRail::Fragments::Factory::Direction direction)
 {
-    // Async HTTP slot calling
-    m_reply = QSharedPointer<QNetworkReply>(m_http->getResource(uri));
+    // Async HTTP slot calling, multiple requests can be in flight at the same time
+    QNetworkReply *reply = m_http->getResource(uri);
     qDebug() << "getPageByURIFromNetworkManager reply:";
-    qDebug() << m_reply;
-    connect(m_reply.data(), SIGNAL(finished()), this, SLOT(processHTTPReply()));
+    qDebug() << reply;
+    QRail::Fragments::Factory::Request request;
+    request.uri = uri;
+    if (caller) {
+        QRail::Fragments::Factory::Caller requestCaller;
+        requestCaller.caller = caller;
+        requestCaller.requestID = requestID;
+        request.callers.append(requestCaller);
+    }
+    request.prefetchDepth = prefetchDepth;
+    request.direction = direction;
+    m_requests.insert(reply, request);
+    m_inFlight.insert(uri, reply);
+    connect(reply, SIGNAL(finished()), this, SLOT(processHTTPReply()));
 }
 
 // Helpers
@@ -258,23 +349,31 @@ QSharedPointer<QRail::Fragments::Fragment> QRail::Fragments::Factory::generateFr
 void QRail::Fragments::Factory::processHTTPReply()
 {
     qDebug() << "Processing HTTP reply";
-    int statusCode = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(this->sender());
+    if (!reply) {
+        qCritical() << "Unknown HTTP reply, ignoring!";
+        return;
+    }
+    QRail::Fragments::Factory::Request request = m_requests.take(reply);
+    m_inFlight.remove(request.uri);
+
+    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     if (statusCode >= 200 && statusCode < 300) {
 #ifdef VERBOSE_HTTP_STATUS
         qDebug() << "Content-Header:"
-                 << m_reply->header(QNetworkRequest::ContentTypeHeader).toString();
+                 << reply->header(QNetworkRequest::ContentTypeHeader).toString();
         qDebug() << "Content-Length:"
-                 << m_reply->header(QNetworkRequest::ContentLengthHeader).toULongLong()
+                 << reply->header(QNetworkRequest::ContentLengthHeader).toULongLong()
                  << "bytes";
         qDebug() << "HTTP status:"
-                 << m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()
-                 << m_reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+                 << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()
+                 << reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
         qDebug() << "Cache:"
-                 << m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+                 << reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
 #endif
 
         // Read HTTP reply
-        QString replyData = (QString)m_reply->readAll();
+        QString replyData = (QString)reply->readAll();
 
         // HTTP 200 OK, create LCPage and LCFragment list
         QList<QSharedPointer<QRail::Fragments::Fragment>> fragments = QList<QSharedPointer<QRail::Fragments::Fragment>>();
@@ -315,8 +414,19 @@ void QRail::Fragments::Factory::processHTTPReply()
                 qDebug() << "Caching page";
                 this->pageCache()->cachePage(page);
 
-                // Page is ready for CSA/Liveboard
-                emit this->pageReady(page);
+                // Page is ready for CSA/Liveboard, keep it aside when nobody asked for it yet
+                if (request.callers.isEmpty()) {
+                    this->addPrefetchedPage(request.uri, page);
+                } else {
+                    emit this->pageReady(page);
+                    foreach (QRail::Fragments::Factory::Caller caller, request.callers) {
+                        emit this->pageDispatched(page, caller.caller, caller.requestID);
+                    }
+                }
+
+                // Keep the pipeline filled
+                this->prefetchPages(request.direction == QRail::Fragments::Factory::Direction::PREVIOUS ? page->hydraPrevious() : page->hydraNext(),
+                                    request.prefetchDepth, request.direction);
             } else {
                 qCritical() << "Fragments context validation failed!";
                 emit this->error(QString("Fragments context validation failed!"));
@@ -326,7 +436,10 @@ void QRail::Fragments::Factory::processHTTPReply()
             emit this->error(QString("Parsing JSON-LD data failed: ").append(parseError.errorString()));
         }
     } else {
-        qCritical() << "Network request failed! HTTP status:" << m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toString();
-        emit this->error(QString("Network request failed! HTTP status:").append(m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toString()).append(m_reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString()));
+        qCritical() << "Network request failed! HTTP status:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toString();
+        emit this->error(QString("Network request failed! HTTP status:").append(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toString()).append(reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString()));
     }
+
+    // Reply is processed, release it once control returns to the event loop
+    reply->deleteLater();
 }
@@ -19,7 +19,10 @@ using namespace QRail;
 
 QRail::Fragments::Fragment::Fragment(QObject *parent) : QObject(parent)
 {
-
+    m_departureStationID = INVALID_URI_ID;
+    m_arrivalStationID = INVALID_URI_ID;
+    m_tripID = INVALID_URI_ID;
+    m_routeID = INVALID_URI_ID;
 }
 
 QRail::Fragments::Fragment::Fragment(
@@ -51,6 +54,12 @@ QRail::Fragments::Fragment::Fragment(
     m_direction = direction;
     m_pickupType = pickupType;
     m_dropOffType = dropOffType;
+
+    // Intern the URIs to allow the router to use dense identifiers
+    m_departureStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(departureStationURI);
+    m_arrivalStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(arrivalStationURI);
+    m_tripID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP)->intern(tripURI);
+    m_routeID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::ROUTE)->intern(routeURI);
 }
 
 // Getter & Setters
@@ -73,9 +82,15 @@ QUrl QRail::Fragments::Fragment::departureStationURI() const
 void QRail::Fragments::Fragment::setDepartureStationURI(const QUrl &departureStationURI)
 {
     m_departureStationURI = departureStationURI;
+    m_departureStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(departureStationURI);
     emit this->departureStationURIChanged();
 }
 
+quint32 QRail::Fragments::Fragment::departureStationID() const
+{
+    return m_departureStationID;
+}
+
 QUrl QRail::Fragments::Fragment::arrivalStationURI() const
 {
     return m_arrivalStationURI;
@@ -84,9 +99,15 @@ QUrl QRail::Fragments::Fragment::arrivalStationURI() const
 void QRail::Fragments::Fragment::setArrivalStationURI(const QUrl &arrivalStationURI)
 {
     m_arrivalStationURI = arrivalStationURI;
+    m_arrivalStationID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::STATION)->intern(arrivalStationURI);
     emit this->arrivalStationURIChanged();
 }
 
+quint32 QRail::Fragments::Fragment::arrivalStationID() const
+{
+    return m_arrivalStationID;
+}
+
 QDateTime QRail::Fragments::Fragment::departureTime() const
 {
     return m_departureTime;
@@ -139,9 +160,15 @@ QUrl QRail::Fragments::Fragment::tripURI() const
 void QRail::Fragments::Fragment::setTripURI(const QUrl &tripURI)
 {
     m_tripURI = tripURI;
+    m_tripID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::TRIP)->intern(tripURI);
     emit this->tripURIChanged();
 }
 
+quint32 QRail::Fragments::Fragment::tripID() const
+{
+    return m_tripID;
+}
+
 QUrl QRail::Fragments::Fragment::routeURI() const
 {
     return m_routeURI;
@@ -150,9 +177,15 @@ QUrl QRail::Fragments::Fragment::routeURI() const
 void QRail::Fragments::Fragment::setRouteURI(const QUrl &routeURI)
 {
     m_routeURI = routeURI;
+    m_routeID = QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type::ROUTE)->intern(routeURI);
     emit this->routeURIChanged();
 }
 
+quint32 QRail::Fragments::Fragment::routeID() const
+{
+    return m_routeID;
+}
+
 QString QRail::Fragments::Fragment::direction() const
 {
     return m_direction;
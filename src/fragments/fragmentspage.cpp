@@ -19,23 +19,20 @@ using namespace QRail;
 
 QRail::Fragments::Page::Page(QObject *parent) : QObject(parent)
 {
-
+    m_connectionTable = QSharedPointer<QRail::Fragments::ConnectionTable>(new QRail::Fragments::ConnectionTable(m_fragments));
 }
 
 QRail::Fragments::Page::Page(const QUrl &uri, const QDateTime &timestamp, const QUrl &hydraNext,
                              const QUrl &hydraPrevious, const QList<QSharedPointer<QRail::Fragments::Fragment>> &fragments, QObject *parent): QObject(parent)
 {
-    // Enforce Page as the parent of all it's children, Qt will delete them when the Page is destroyed
-    foreach (QSharedPointer<QRail::Fragments::Fragment> frag, fragments) {
-        frag->setParent(this);
-    }
-
-    // Avoid signal triggering on contruction
+    // Avoid signal triggering on contruction, the fragments are owned by their shared pointers
+    // since profiles, routes and caches keep them alive after the Page is destroyed
     m_uri = uri;
     m_timestamp = timestamp;
     m_hydraNext = hydraNext;
     m_hydraPrevious = hydraPrevious;
     m_fragments = fragments;
+    m_connectionTable = QSharedPointer<QRail::Fragments::ConnectionTable>(new QRail::Fragments::ConnectionTable(m_fragments));
 }
 
 
@@ -91,5 +88,11 @@ QList<QSharedPointer<QRail::Fragments::Fragment>> QRail::Fragments::Page::fragme
 void QRail::Fragments::Page::setFragments(const QList<QSharedPointer<QRail::Fragments::Fragment>> &fragments)
 {
     m_fragments = fragments;
+    m_connectionTable = QSharedPointer<QRail::Fragments::ConnectionTable>(new QRail::Fragments::ConnectionTable(m_fragments));
     emit this->fragmentsChanged();
 }
+
+QSharedPointer<QRail::Fragments::ConnectionTable> QRail::Fragments::Page::connectionTable() const
+{
+    return m_connectionTable;
+}
@@ -0,0 +1,401 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragments/fragmentspagestore.h"
+using namespace QRail;
+using namespace Fragments;
+
+PageStore::PageStore(const QString &path)
+{
+    m_map = nullptr;
+    m_mapSize = 0;
+    m_deadBytes = 0;
+    m_index = QHash<QUrl, QRail::Fragments::PageStore::Entry>();
+
+    m_file.setFileName(path);
+    if(!m_file.open(QIODevice::ReadWrite)) {
+        qCritical() << "Unable to open page store" << path << m_file.errorString();
+        return;
+    }
+    this->scan();
+}
+
+PageStore::~PageStore()
+{
+    this->unmap();
+    m_file.close();
+}
+
+bool PageStore::write(QSharedPointer<QRail::Fragments::Page> page)
+{
+    QByteArray payload = this->encode(page);
+    QMutexLocker locker(&m_mutex);
+
+    if(!m_file.isOpen()) {
+        return false;
+    }
+
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << quint32(PAGE_STORE_MAGIC) << quint32(payload.size());
+    record.append(payload);
+
+    // Records are only appended, a crash can at most leave a truncated record at the end
+    qint64 offset = m_file.size();
+    m_file.seek(offset);
+    if(m_file.write(record) != record.size() || !m_file.flush()) {
+        qCritical() << "Unable to write page" << page->uri() << "to page store:" << m_file.errorString();
+        m_file.resize(offset);
+        return false;
+    }
+
+    QRail::Fragments::PageStore::Entry entry;
+    entry.uri = page->uri();
+    entry.hydraNext = page->hydraNext();
+    entry.firstDepartureTime = page->fragments().size() > 0 ? page->fragments().first()->departureTime() : QDateTime();
+    entry.offset = offset + PAGE_STORE_HEADER_SIZE;
+    entry.length = payload.size();
+    if(m_index.contains(entry.uri)) {
+        m_deadBytes += m_index.value(entry.uri).length + PAGE_STORE_HEADER_SIZE;
+    }
+    m_index.insert(entry.uri, entry);
+
+    if(m_deadBytes > m_file.size() / 2) {
+        this->compact();
+    }
+    return true;
+}
+
+QSharedPointer<QRail::Fragments::Page> PageStore::read(const QUrl &uri)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if(!m_index.contains(uri)) {
+        return QSharedPointer<QRail::Fragments::Page>();
+    }
+
+    QRail::Fragments::PageStore::Entry entry = m_index.value(uri);
+    const uchar *data = this->map(entry.offset, entry.length);
+    if(!data) {
+        qCritical() << "Unable to map page store" << m_file.errorString();
+        return QSharedPointer<QRail::Fragments::Page>();
+    }
+
+    // The record is decoded straight from the mapped file without copying it
+    QSharedPointer<QRail::Fragments::Page> page = this->decode(QByteArray::fromRawData(reinterpret_cast<const char *>(data), entry.length));
+    if(!page) {
+        qCritical() << "Corrupt page" << uri << "in page store, dropping it";
+        m_index.remove(uri);
+    }
+    return page;
+}
+
+bool PageStore::contains(const QUrl &uri) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_index.contains(uri);
+}
+
+QList<PageStore::Entry> PageStore::entries() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_index.values();
+}
+
+void PageStore::scan()
+{
+    qint64 size = m_file.size();
+    qint64 offset = 0;
+    const uchar *data = this->map(0, size);
+
+    while(data && offset + PAGE_STORE_HEADER_SIZE <= size) {
+        QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char *>(data + offset), PAGE_STORE_HEADER_SIZE);
+        QDataStream headerStream(header);
+        headerStream.setVersion(QDataStream::Qt_5_6);
+        quint32 magic;
+        quint32 length;
+        headerStream >> magic >> length;
+        if(magic != PAGE_STORE_MAGIC || offset + PAGE_STORE_HEADER_SIZE + length > size) {
+            break;
+        }
+
+        // Only the header of the record is decoded, the page itself is decoded when it's read
+        QByteArray payload = QByteArray::fromRawData(reinterpret_cast<const char *>(data + offset + PAGE_STORE_HEADER_SIZE), length);
+        QDataStream payloadStream(payload);
+        payloadStream.setVersion(QDataStream::Qt_5_6);
+        QRail::Fragments::PageStore::Entry entry;
+        if(!PageStore::readHeader(payloadStream, entry)) {
+            break;
+        }
+        entry.offset = offset + PAGE_STORE_HEADER_SIZE;
+        entry.length = length;
+        if(m_index.contains(entry.uri)) {
+            m_deadBytes += m_index.value(entry.uri).length + PAGE_STORE_HEADER_SIZE;
+        }
+        m_index.insert(entry.uri, entry);
+        offset += PAGE_STORE_HEADER_SIZE + length;
+    }
+
+    // Drop a record which was only partially written
+    if(offset < size) {
+        qWarning() << "Page store truncated at" << offset << "of" << size << "bytes";
+        this->unmap();
+        m_file.resize(offset);
+    }
+
+    qDebug() << "Pages available in page store:" << m_index.size();
+    if(m_deadBytes > m_file.size() / 2) {
+        this->compact();
+    }
+}
+
+void PageStore::compact()
+{
+    /*
+     * The compacted records are written to a temporary file which atomically replaces the store on commit.
+     * A crash or a failure before that leaves the old store and its index untouched.
+     */
+    QString path = m_file.fileName();
+    QSaveFile compacted(path);
+    if(!compacted.open(QIODevice::WriteOnly)) {
+        qCritical() << "Unable to compact page store:" << compacted.errorString();
+        return;
+    }
+
+    // Copy the most recent record of every page, the records themselves aren't decoded
+    QHash<QUrl, QRail::Fragments::PageStore::Entry> index;
+    qint64 offset = 0;
+    foreach(QRail::Fragments::PageStore::Entry entry, m_index.values()) {
+        const uchar *data = this->map(entry.offset, entry.length);
+        QByteArray record;
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_6);
+        stream << quint32(PAGE_STORE_MAGIC) << quint32(entry.length);
+        if(!data || compacted.write(record) != record.size()
+                || compacted.write(reinterpret_cast<const char *>(data), entry.length) != entry.length) {
+            qCritical() << "Unable to compact page store:" << compacted.errorString();
+            compacted.cancelWriting();
+            return;
+        }
+        entry.offset = offset + PAGE_STORE_HEADER_SIZE;
+        index.insert(entry.uri, entry);
+        offset += PAGE_STORE_HEADER_SIZE + entry.length;
+    }
+
+    // The old file stays open and mapped until the compacted one replaced it
+    if(!compacted.commit()) {
+        qCritical() << "Unable to replace page store:" << compacted.errorString();
+        return;
+    }
+
+    this->unmap();
+    m_file.close();
+    if(!m_file.open(QIODevice::ReadWrite)) {
+        qCritical() << "Unable to open compacted page store:" << m_file.errorString();
+        m_index.clear();
+        return;
+    }
+    m_index = index;
+    m_deadBytes = 0;
+    qDebug() << "Page store compacted to" << m_file.size() << "bytes";
+}
+
+const uchar *PageStore::map(const qint64 offset, const quint32 length)
+{
+    // Records appended after the file was mapped require a new mapping
+    if(offset + length > m_mapSize) {
+        this->unmap();
+        qint64 size = m_file.size();
+        if(size == 0 || offset + length > size) {
+            return nullptr;
+        }
+        m_map = m_file.map(0, size);
+        if(!m_map) {
+            return nullptr;
+        }
+        m_mapSize = size;
+    }
+    return m_map + offset;
+}
+
+void PageStore::unmap()
+{
+    if(m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+}
+
+QByteArray PageStore::encode(QSharedPointer<QRail::Fragments::Page> page) const
+{
+    // Stations, trips and routes are shared by many connections, intern them in the string table
+    QVector<QString> strings;
+    QHash<QString, quint32> stringIDs;
+    auto intern = [&strings, &stringIDs](const QString &string) -> quint32 {
+        QHash<QString, quint32>::const_iterator it = stringIDs.constFind(string);
+        if(it != stringIDs.constEnd()) {
+            return it.value();
+        }
+        quint32 id = strings.size();
+        strings.append(string);
+        stringIDs.insert(string, id);
+        return id;
+    };
+
+    QByteArray fragments;
+    QDataStream fragmentStream(&fragments, QIODevice::WriteOnly);
+    fragmentStream.setVersion(QDataStream::Qt_5_6);
+    fragmentStream << quint32(page->fragments().size());
+    foreach(QSharedPointer<QRail::Fragments::Fragment> fragment, page->fragments()) {
+        fragmentStream << intern(fragment->uri().toString())
+                       << intern(fragment->departureStationURI().toString())
+                       << intern(fragment->arrivalStationURI().toString())
+                       << intern(fragment->tripURI().toString())
+                       << intern(fragment->routeURI().toString())
+                       << intern(fragment->direction())
+                       << PageStore::toMSecs(fragment->departureTime())
+                       << PageStore::toMSecs(fragment->arrivalTime())
+                       << qint16(fragment->departureDelay())
+                       << qint16(fragment->arrivalDelay())
+                       << quint8(fragment->pickupType())
+                       << quint8(fragment->dropOffType());
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << quint8(PAGE_STORE_VERSION)
+           << page->uri().toString()
+           << page->hydraNext().toString()
+           << PageStore::toMSecs(page->fragments().size() > 0 ? page->fragments().first()->departureTime() : QDateTime())
+           << page->hydraPrevious().toString()
+           << PageStore::toMSecs(page->timestamp());
+    stream << quint32(strings.size());
+    foreach(QString string, strings) {
+        stream << string;
+    }
+    payload.append(fragments);
+    return payload;
+}
+
+QSharedPointer<QRail::Fragments::Page> PageStore::decode(const QByteArray &record) const
+{
+    QDataStream stream(record);
+    stream.setVersion(QDataStream::Qt_5_6);
+    QRail::Fragments::PageStore::Entry entry;
+    if(!PageStore::readHeader(stream, entry)) {
+        return QSharedPointer<QRail::Fragments::Page>();
+    }
+
+    QString hydraPrevious;
+    qint64 timestamp;
+    quint32 stringCount;
+    stream >> hydraPrevious >> timestamp >> stringCount;
+    QVector<QString> strings;
+    strings.reserve(stringCount);
+    for(quint32 i = 0; i < stringCount && stream.status() == QDataStream::Ok; i++) {
+        QString string;
+        stream >> string;
+        strings.append(string);
+    }
+
+    // Every interned URI is only parsed once
+    QVector<QUrl> uris(strings.size());
+    auto uri = [&strings, &uris](const quint32 id) -> QUrl {
+        if(uris.at(id).isEmpty()) {
+            uris[id] = QUrl(strings.at(id));
+        }
+        return uris.at(id);
+    };
+
+    quint32 fragmentCount;
+    stream >> fragmentCount;
+    QList<QSharedPointer<QRail::Fragments::Fragment>> fragments;
+    fragments.reserve(fragmentCount);
+    for(quint32 i = 0; i < fragmentCount && stream.status() == QDataStream::Ok; i++) {
+        quint32 uriID, departureStationID, arrivalStationID, tripID, routeID, directionID;
+        qint64 departureTime, arrivalTime;
+        qint16 departureDelay, arrivalDelay;
+        quint8 pickupType, dropOffType;
+        stream >> uriID >> departureStationID >> arrivalStationID >> tripID >> routeID >> directionID
+               >> departureTime >> arrivalTime >> departureDelay >> arrivalDelay >> pickupType >> dropOffType;
+
+        quint32 count = strings.size();
+        if(uriID >= count || departureStationID >= count || arrivalStationID >= count
+                || tripID >= count || routeID >= count || directionID >= count) {
+            return QSharedPointer<QRail::Fragments::Page>();
+        }
+
+        QSharedPointer<QRail::Fragments::Fragment> fragment = QSharedPointer<QRail::Fragments::Fragment>(new QRail::Fragments::Fragment());
+        fragment->setURI(uri(uriID));
+        fragment->setDepartureStationURI(uri(departureStationID));
+        fragment->setArrivalStationURI(uri(arrivalStationID));
+        fragment->setDepartureTime(PageStore::fromMSecs(departureTime));
+        fragment->setArrivalTime(PageStore::fromMSecs(arrivalTime));
+        fragment->setDepartureDelay(departureDelay);
+        fragment->setArrivalDelay(arrivalDelay);
+        fragment->setTripURI(uri(tripID));
+        fragment->setRouteURI(uri(routeID));
+        fragment->setDirection(strings.at(directionID));
+        fragment->setPickupType(static_cast<QRail::Fragments::Fragment::GTFSTypes>(pickupType));
+        fragment->setDropOffType(static_cast<QRail::Fragments::Fragment::GTFSTypes>(dropOffType));
+        fragments.append(fragment);
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        return QSharedPointer<QRail::Fragments::Page>();
+    }
+
+    QSharedPointer<QRail::Fragments::Page> page = QSharedPointer<QRail::Fragments::Page>(new QRail::Fragments::Page());
+    page->setURI(entry.uri);
+    page->setHydraNext(entry.hydraNext);
+    page->setHydraPrevious(QUrl(hydraPrevious));
+    page->setTimestamp(PageStore::fromMSecs(timestamp));
+    page->setFragments(fragments);
+    return page;
+}
+
+bool PageStore::readHeader(QDataStream &stream, PageStore::Entry &entry)
+{
+    quint8 version;
+    QString uri;
+    QString hydraNext;
+    qint64 firstDepartureTime;
+    stream >> version;
+    if(version != PAGE_STORE_VERSION) {
+        return false;
+    }
+    stream >> uri >> hydraNext >> firstDepartureTime;
+    entry.uri = QUrl(uri);
+    entry.hydraNext = QUrl(hydraNext);
+    entry.firstDepartureTime = PageStore::fromMSecs(firstDepartureTime);
+    return stream.status() == QDataStream::Ok;
+}
+
+qint64 PageStore::toMSecs(const QDateTime &time)
+{
+    return time.isValid() ? time.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+}
+
+QDateTime PageStore::fromMSecs(const qint64 msecs)
+{
+    if(msecs == std::numeric_limits<qint64>::min()) {
+        return QDateTime();
+    }
+    return QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+}
@@ -0,0 +1,100 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragments/fragmentspagewriter.h"
+using namespace QRail;
+using namespace Fragments;
+
+PageWriter::PageWriter(QRail::Fragments::PageStore *store, QObject *parent) : QObject(parent)
+{
+    m_store = store;
+    m_dirty = QHash<QUrl, QSharedPointer<QRail::Fragments::Page>>();
+    m_dirtyOrder = QList<QUrl>();
+    m_writing = QHash<QUrl, QSharedPointer<QRail::Fragments::Page>>();
+}
+
+void PageWriter::enqueue(QSharedPointer<QRail::Fragments::Page> page)
+{
+    // Snapshot the page, the fragments are shared since updates replace them instead of modifying them
+    QSharedPointer<QRail::Fragments::Page> snapshot = QSharedPointer<QRail::Fragments::Page>(new QRail::Fragments::Page());
+    snapshot->setURI(page->uri());
+    snapshot->setTimestamp(page->timestamp());
+    snapshot->setHydraNext(page->hydraNext());
+    snapshot->setHydraPrevious(page->hydraPrevious());
+    snapshot->setFragments(page->fragments());
+
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        wasEmpty = m_dirty.isEmpty();
+        if(!m_dirty.contains(snapshot->uri())) {
+            m_dirtyOrder.append(snapshot->uri());
+        }
+        m_dirty.insert(snapshot->uri(), snapshot);
+    }
+
+    // The first dirty page starts the flush interval, following pages are coalesced into the same flush
+    if(wasEmpty) {
+        QMetaObject::invokeMethod(this, "scheduleFlush", Qt::QueuedConnection);
+    }
+}
+
+QSharedPointer<QRail::Fragments::Page> PageWriter::pendingPage(const QUrl &uri) const
+{
+    QMutexLocker locker(&m_queueMutex);
+    if(m_dirty.contains(uri)) {
+        return m_dirty.value(uri);
+    }
+    return m_writing.value(uri);
+}
+
+qint32 PageWriter::pendingCount() const
+{
+    QMutexLocker locker(&m_queueMutex);
+    return m_dirty.size();
+}
+
+void PageWriter::flush()
+{
+    // Flushes are serialized, an older snapshot can never overwrite a newer one
+    QMutexLocker flushLocker(&m_flushMutex);
+    QList<QUrl> order;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        order.swap(m_dirtyOrder);
+        m_writing.swap(m_dirty);
+    }
+
+    if(order.isEmpty()) {
+        return;
+    }
+
+    // Pages being written stay available through pendingPage() until they're in the store
+    foreach(QUrl uri, order) {
+        m_store->write(m_writing.value(uri));
+    }
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_writing.clear();
+    }
+    qDebug() << "Written" << order.size() << "pages to disk cache";
+}
+
+void PageWriter::scheduleFlush()
+{
+    QTimer::singleShot(PAGE_WRITER_FLUSH_INTERVAL, this, SLOT(flush()));
+}
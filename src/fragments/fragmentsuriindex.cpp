@@ -0,0 +1,80 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragments/fragmentsuriindex.h"
+using namespace QRail;
+QRail::Fragments::URIIndex *QRail::Fragments::URIIndex::m_instances[3] = { nullptr, nullptr, nullptr };
+
+QRail::Fragments::URIIndex::URIIndex()
+{
+    m_ids = QHash<QUrl, quint32>();
+    m_uris = QVector<QUrl>();
+}
+
+QRail::Fragments::URIIndex *QRail::Fragments::URIIndex::getInstance(QRail::Fragments::URIIndex::Type type)
+{
+    // Singleton pattern, one instance for each type
+    qint32 slot = static_cast<qint32>(type);
+    if (m_instances[slot] == nullptr) {
+        m_instances[slot] = new URIIndex();
+    }
+    return m_instances[slot];
+}
+
+quint32 QRail::Fragments::URIIndex::intern(const QUrl &uri)
+{
+    // Fast path: most URIs are already known after the first page
+    {
+        QReadLocker readLocker(&m_lock);
+        QHash<QUrl, quint32>::const_iterator it = m_ids.constFind(uri);
+        if (it != m_ids.constEnd()) {
+            return it.value();
+        }
+    }
+
+    // Another thread might have interned the URI in the meantime
+    QWriteLocker writeLocker(&m_lock);
+    QHash<QUrl, quint32>::const_iterator it = m_ids.constFind(uri);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+
+    quint32 id = static_cast<quint32>(m_uris.size());
+    m_uris.append(uri);
+    m_ids.insert(uri, id);
+    return id;
+}
+
+quint32 QRail::Fragments::URIIndex::id(const QUrl &uri) const
+{
+    QReadLocker readLocker(&m_lock);
+    return m_ids.value(uri, INVALID_URI_ID);
+}
+
+QUrl QRail::Fragments::URIIndex::uri(const quint32 id) const
+{
+    QReadLocker readLocker(&m_lock);
+    if (id < static_cast<quint32>(m_uris.size())) {
+        return m_uris.at(id);
+    }
+    return QUrl();
+}
+
+quint32 QRail::Fragments::URIIndex::count() const
+{
+    QReadLocker readLocker(&m_lock);
+    return static_cast<quint32>(m_uris.size());
+}
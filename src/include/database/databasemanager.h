@@ -86,7 +86,7 @@ public:
 
 private:
     static QThreadStorage<QSqlDatabase> m_database;
-    static QThreadStorage<QString> m_path;
+    QString m_path;
     explicit Manager(const QString &path, QObject *parent = nullptr);
     static Manager *m_instance;
 };
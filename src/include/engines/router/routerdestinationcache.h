@@ -0,0 +1,100 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERDESTINATIONCACHE_H
+#define ROUTERDESTINATIONCACHE_H
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QUrl>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QDebug>
+
+#include "engines/router/routerstationstopprofile.h"
+
+#define DESTINATION_CACHE_SIZE 16 // 16 destinations with cached profiles
+
+namespace QRail {
+namespace RouterEngine {
+//! A RouterEngine::DestinationCache keeps the station profiles towards recent destinations.
+/*!
+    \class DestinationCache
+    The Profile CSA computes the profiles towards the destination for every station.
+    A query from any departure station towards a cached destination is answered by extracting
+    the routes from these profiles when its time window is covered.
+    The cache is thread safe and can be shared by the planners of a RouterEngine::PlannerPool.
+    The station profiles are never modified after they're cached, the planners only read them.
+ */
+class DestinationCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Profile {
+        qint64 departureTime;
+        qint64 arrivalTime;
+        qint16 maxTransfers;
+        quint64 updateVersion;
+        QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray;
+        QList<QUrl> pageURIs;
+    };
+    //! QRail::RouterEngine::DestinationCache constructor.
+    /*!
+        \param parent QObject parent-child memory management.
+        \public
+        Constructs an empty QRail::RouterEngine::DestinationCache.
+     */
+    explicit DestinationCache(QObject *parent = nullptr);
+    //! Gets the cached profiles towards a destination.
+    /*!
+        \param destination The URI of the arrival station.
+        \param updateVersion The current update version of the Fragments::Factory.
+        \param profile Set to the cached profiles when they're found.
+        \return True when up to date profiles are cached for the destination.
+        \public
+        Profiles computed before a real time update are evicted.
+     */
+    bool profile(const QUrl &destination, const quint64 updateVersion, QRail::RouterEngine::DestinationCache::Profile *profile);
+    //! Adds the profiles towards a destination.
+    /*!
+        \param destination The URI of the arrival station.
+        \param profile The profiles towards the destination.
+        \public
+        The latest profiles replace the cached ones, the least recently stored destination is evicted when the cache is full.
+     */
+    void insert(const QUrl &destination, const QRail::RouterEngine::DestinationCache::Profile &profile);
+    //! Removes every destination from the cache.
+    void clear();
+    //! Gets the number of cached destinations.
+    qint32 size() const;
+    //! Gets the maximum number of cached destinations.
+    qint32 maxSize() const;
+    //! Sets the maximum number of cached destinations, 0 disables the cache.
+    void setMaxSize(const qint32 maxSize);
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QUrl, QRail::RouterEngine::DestinationCache::Profile> m_profiles;
+    QList<QUrl> m_order;
+    qint32 m_maxSize;
+};
+}
+}
+
+#endif // ROUTERDESTINATIONCACHE_H
@@ -6,6 +6,7 @@
 #include <QtCore/QUrl>
 #include <QtCore/QUrlQuery>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
 
 #include "engines/router/routerroute.h"
 #include "engines/router/routerstationstopprofile.h"
@@ -122,32 +123,33 @@ public:
     void setArrivalTime(const QDateTime &arrivalTime);
     //! Gets the T array for the Earliest Arrival CSA of the Journey.
     /*!
-        \return T_EarliestArrivalTime T array for Earliest Arrival CSA.
+        \return T_EarliestArrivalTime T array for Earliest Arrival CSA, indexed by trip ID.
         \public
         Gets the T array for the Earliest Arrival CSA of the Journey and returns it.
      */
-    QMap<QUrl, qint16> T_EarliestArrivalTime() const;
+    QVector<qint16> T_EarliestArrivalTime() const;
     //! Sets the T array for the Earliest Arrival CSA of the Journey.
     /*!
         \param T_EarliestArrivalTime T array for Earliest Arrival CSA.
         \public
         Sets the T array for the Earliest Arrival CSA of the Journey.
      */
-    void setT_EarliestArrivalTime(const QMap<QUrl, qint16> &T_EarliestArrivalTime);
+    void setT_EarliestArrivalTime(const QVector<qint16> &T_EarliestArrivalTime);
     //! Gets the S array for the Earliest Arrival CSA of the Journey.
     /*!
-        \return S_EarliestArrivalTime S array for Earliest Arrival CSA.
+        \return S_EarliestArrivalTime S array for Earliest Arrival CSA, indexed by station ID.
+        \note The times are stored in seconds since the UNIX epoch, 0 if the station isn't reached yet.
         \public
         Gets the S array for the Earliest Arrival CSA of the Journey and returns it.
      */
-    QMap<QUrl, QDateTime> S_EarliestArrivalTime() const;
+    QVector<qint64> S_EarliestArrivalTime() const;
     //! Sets the S array for the Earliest Arrival CSA of the Journey.
     /*!
         \param S_EarliestArrivalTime S array for Earliest Arrival CSA.
         \public
         Sets the S array for the Earliest Arrival CSA of the Journey.
      */
-    void setS_EarliestArrivalTime(const QMap<QUrl, QDateTime> &S_EarliestArrivalTime);
+    void setS_EarliestArrivalTime(const QVector<qint64> &S_EarliestArrivalTime);
     //! Gets the departure station URI of the Journey.
     /*!
         \return departureStationURI The URI of the departure station.
@@ -178,32 +180,135 @@ public:
     void setArrivalStationURI(const QUrl &arrivalStationURI);
     //! Gets the T array for the Profile CSA of the Journey.
     /*!
-        \return TArray T array for Profile CSA.
+        \return TArray T array for Profile CSA, indexed by trip ID.
         \public
         Gets the T array for the Profile CSA of the Journey and returns it.
      */
-    QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > TArray() const;
+    QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > TArray() const;
     //! Sets the T array for the Profile CSA of the Journey.
     /*!
         \return TArray T array for Profile CSA.
         \public
         Sets the T array for the Profile CSA of the Journey.
      */
-    void setTArray(const QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > &TArray);
+    void setTArray(const QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > &TArray);
     //! Gets the S array for the Profile CSA of the Journey.
     /*!
-        \return SArray T array for Profile CSA.
+        \return SArray S array for Profile CSA, indexed by station ID.
         \public
         Gets the S array for the Profile CSA of the Journey and returns it.
      */
-    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray() const;
+    QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray() const;
     //! Sets the S array for the Profile CSA of the Journey.
     /*!
         \param SArray T array for Profile CSA.
         \public
         Sets the S array for the Profile CSA of the Journey.
      */
-    void setSArray(const QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > &SArray);
+    void setSArray(const QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > &SArray);
+    //! Gets the T array entry for the Earliest Arrival CSA of a trip.
+    /*!
+        \param tripID The identifier of the trip.
+        \return The number of reachable connections of the trip, 0 if the trip isn't reachable.
+        \public
+        Gets the T array entry for the Earliest Arrival CSA without copying the array.
+     */
+    qint16 T_EarliestArrivalTimeAt(const quint32 tripID) const;
+    //! Sets the T array entry for the Earliest Arrival CSA of a trip.
+    /*!
+        \param tripID The identifier of the trip.
+        \param count The number of reachable connections of the trip.
+        \public
+        Updates the T array for the Earliest Arrival CSA in place.
+     */
+    void setT_EarliestArrivalTimeAt(const quint32 tripID, const qint16 count);
+    //! Gets the S array entry for the Earliest Arrival CSA of a station.
+    /*!
+        \param stationID The identifier of the station.
+        \return The earliest arrival time in seconds since the UNIX epoch, 0 if the station isn't reached yet.
+        \public
+        Gets the S array entry for the Earliest Arrival CSA without copying the array.
+     */
+    qint64 S_EarliestArrivalTimeAt(const quint32 stationID) const;
+    //! Sets the S array entry for the Earliest Arrival CSA of a station.
+    /*!
+        \param stationID The identifier of the station.
+        \param earliestArrivalTime The earliest arrival time in seconds since the UNIX epoch.
+        \public
+        Updates the S array for the Earliest Arrival CSA in place.
+     */
+    void setS_EarliestArrivalTimeAt(const quint32 stationID, const qint64 earliestArrivalTime);
+    //! Gets the T array entry for the Profile CSA of a trip.
+    /*!
+        \param tripID The identifier of the trip.
+        \return The RouterEngine::TrainProfile of the trip, a null pointer if the trip has no profile yet.
+        \public
+        Gets the T array entry for the Profile CSA without copying the array.
+     */
+    QSharedPointer<QRail::RouterEngine::TrainProfile> TArrayAt(const quint32 tripID) const;
+    //! Sets the T array entry for the Profile CSA of a trip.
+    /*!
+        \param tripID The identifier of the trip.
+        \param trainProfile The new RouterEngine::TrainProfile of the trip.
+        \public
+        Updates the T array for the Profile CSA in place.
+     */
+    void setTArrayAt(const quint32 tripID, const QSharedPointer<QRail::RouterEngine::TrainProfile> &trainProfile);
+    //! Gets the S array entry for the Profile CSA of a station.
+    /*!
+        \param stationID The identifier of the station.
+        \return The RouterEngine::StationStopProfile list of the station, sorted by DESCENDING departure time.
+        \note The reference is only valid until the S array is modified.
+        \public
+        Gets the S array entry for the Profile CSA without copying the array or the list.
+     */
+    const QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > &SArrayAt(const quint32 stationID) const;
+    //! Appends a profile to the S array entry for the Profile CSA of a station.
+    /*!
+        \param stationID The identifier of the station.
+        \param stationStopProfile The RouterEngine::StationStopProfile to add at the back.
+        \public
+        Updates the S array for the Profile CSA in place.
+     */
+    void appendSArrayAt(const quint32 stationID, const QSharedPointer<QRail::RouterEngine::StationStopProfile> &stationStopProfile);
+    //! Replaces the last profile of the S array entry for the Profile CSA of a station.
+    /*!
+        \param stationID The identifier of the station.
+        \param stationStopProfile The RouterEngine::StationStopProfile which replaces the one at the back.
+        \public
+        Updates the S array for the Profile CSA in place.
+     */
+    void replaceLastSArrayAt(const quint32 stationID, const QSharedPointer<QRail::RouterEngine::StationStopProfile> &stationStopProfile);
+    //! Searches the S array entry of a station for the earliest reachable departure.
+    /*!
+        \param stationID The identifier of the station.
+        \param earliestDepartureTime The earliest departure time in seconds since the UNIX epoch we can catch.
+        \return The index of the RouterEngine::StationStopProfile with the earliest departure time later than or equal to the given time, -1 if none exists.
+        \public
+        The profiles are sorted by DESCENDING departure time, a binary search is used to find the index.
+     */
+    qint32 lastReachableSArrayIndex(const quint32 stationID, const qint64 earliestDepartureTime) const;
+    //! Searches the S array entry of a station for the earliest arrival we can transfer to.
+    /*!
+        \param stationID The identifier of the station.
+        \param earliestDepartureTime The earliest departure time in seconds since the UNIX epoch we can catch.
+        \return The index of the reachable RouterEngine::StationStopProfile with the earliest arrival time
+                and less transfers than maxTransfers(), -1 if none exists.
+        \public
+        A binary search finds the earliest reachable departure, a transfer index kept next to the S array
+        gives the closest profile with an allowed number of transfers in constant time.
+     */
+    qint32 lastTransferableSArrayIndex(const quint32 stationID, const qint64 earliestDepartureTime) const;
+    //! Searches the S array entry of a station for a given arrival time.
+    /*!
+        \param stationID The identifier of the station.
+        \param arrivalTime The arrival time in seconds since the UNIX epoch.
+        \return The index of the RouterEngine::StationStopProfile with the given arrival time, -1 if none exists.
+        \public
+        Dominated profiles are never inserted, the profiles are sorted by DESCENDING arrival time too.
+        A binary search is used to find the index.
+     */
+    qint32 indexOfSArrayArrivalTime(const quint32 stationID, const qint64 arrivalTime) const;
     //! Gets the maximum amount of transfers for the Journey.
     /*!
         \return station StationEngine::Station object with information about the associated station.
@@ -220,8 +325,66 @@ public:
         Sets the maximum amount of transfers for the Journey.
      */
     void setMaxTransfers(const qint16 &maxTransfers);
+    //! Grows the S and T arrays of the Journey.
+    /*!
+        \param stationCount The number of interned stations.
+        \param tripCount The number of interned trips.
+        \public
+        The S and T arrays are indexed by the identifiers of the Fragments::URIIndex.
+        When new stations or trips are interned, the arrays are grown to make every identifier a valid index.
+     */
+    void resizeArrays(const quint32 stationCount, const quint32 tripCount);
+    //! Gets the latest departure time of the Journey.
+    /*!
+        \return Only routes departing before this time are extracted, invalid for no limit.
+        \public
+     */
+    QDateTime latestDepartureTime() const;
+    //! Sets the latest departure time of the Journey.
+    /*!
+        \param latestDepartureTime The end of the departure time window, invalid for no limit.
+        \public
+     */
+    void setLatestDepartureTime(const QDateTime &latestDepartureTime);
+    //! Checks if the Journey is a partial result.
+    /*!
+        \return true if the planner was stopped by a deadline before it passed the departure time.
+        \public
+        The routes of a partial Journey are valid, but earlier or faster routes might be missing.
+     */
+    bool isPartial() const;
+    //! Marks the Journey as a partial result.
+    /*!
+        \param partial true if the scan was stopped before the departure time.
+        \public
+     */
+    void setPartial(const bool partial);
+    //! Gets the URIs of the Linked Connections pages used by the Journey.
+    /*!
+        \return The URIs of every page which has been scanned for this Journey.
+        \public
+        The routes of the Journey are outdated when one of these pages is updated.
+     */
+    QList<QUrl> pageURIs() const;
+    //! Sets the URIs of the Linked Connections pages used by the Journey.
+    /*!
+        \param pageURIs The URIs of the pages the Journey depends on.
+        \public
+     */
+    void setPageURIs(const QList<QUrl> &pageURIs);
+    //! Adds the URI of a scanned Linked Connections page to the Journey.
+    /*!
+        \param pageURI The URI of the page, duplicates are ignored.
+        \public
+     */
+    void addPageURI(const QUrl &pageURI);
 
     //! Add a SnapshotJourney object to this Journey
+    /*!
+        \param snapshotJourney An empty SnapshotJourney for the page which is about to be processed.
+        \note All changes made through the in place setters are recorded in the latest SnapshotJourney.
+        \public
+     */
     void addSnapshotJourney(QRail::RouterEngine::SnapshotJourney *snapshotJourney);
     //! Restore Journey before page
     QDateTime restoreBeforePage(const QUrl pageURI);
@@ -233,6 +396,10 @@ public:
     void resetJourney();
 
 private:
+    QRail::RouterEngine::SnapshotJourney *currentSnapshot() const;
+    void undoSnapshot(QRail::RouterEngine::SnapshotJourney *snapshotJourney);
+    void updateLastSTransferIndex(const quint32 stationID);
+    void rebuildSTransferIndex();
     QList<QRail::RouterEngine::SnapshotJourney *> m_snapshotJourneys;
     QList<QSharedPointer<QRail::RouterEngine::Route> > m_routes;
     QDateTime m_departureTime;
@@ -242,10 +409,14 @@ private:
     QUrl m_hydraPrevious;
     QUrl m_departureStationURI;
     QUrl m_arrivalStationURI;
-    QMap<QUrl, qint16> m_T_EarliestArrivalTime;
-    QMap<QUrl, QDateTime> m_S_EarliestArrivalTime;
-    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > m_SArray;
-    QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > m_TArray;
+    QList<QUrl> m_pageURIs;
+    QDateTime m_latestDepartureTime;
+    bool m_partial;
+    QVector<qint16> m_T_EarliestArrivalTime;
+    QVector<qint64> m_S_EarliestArrivalTime;
+    QVector<QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > m_SArray;
+    QVector<QVector<qint32> > m_STransferIndex;
+    QVector<QSharedPointer<QRail::RouterEngine::TrainProfile> > m_TArray;
 };
 }
 }
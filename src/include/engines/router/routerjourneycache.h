@@ -0,0 +1,128 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERJOURNEYCACHE_H
+#define ROUTERJOURNEYCACHE_H
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QList>
+#include <QtCore/QUrl>
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QDebug>
+
+#include "engines/router/routerjourney.h"
+#include "engines/router/routerquery.h"
+#include "fragments/fragmentsfragment.h"
+
+#define JOURNEY_CACHE_SIZE 64          // 64 Journeys
+#define JOURNEY_CACHE_BUCKET_SIZE 60   // 60 s, departure times are rounded down to the minute
+
+namespace QRail {
+namespace RouterEngine {
+//! A RouterEngine::JourneyCache keeps the results of recent queries.
+/*!
+    \class JourneyCache
+    Queries with the same stations, maximum amount of transfers and a departure time in the same
+    time bucket are answered with the routes of the cached Journey when the cached Journey covers
+    the departure time window of the query. Only the routes inside that window are returned.
+    Queries without a latest departure time are only answered by a Journey with the same departure time.
+    The cache is thread safe and can be shared by the planners of a RouterEngine::PlannerPool.
+    Every cached Journey depends on the Linked Connections pages which were scanned for it and on
+    the connections used by its routes. The Journey is evicted as soon as one of them is updated.
+ */
+class JourneyCache : public QObject
+{
+    Q_OBJECT
+public:
+    //! QRail::RouterEngine::JourneyCache constructor.
+    /*!
+        \param parent QObject parent-child memory management.
+        \public
+        Constructs an empty QRail::RouterEngine::JourneyCache.
+     */
+    explicit JourneyCache(QObject *parent = nullptr);
+    //! Gets the cached routes for a query.
+    /*!
+        \param query The query to look up.
+        \param ok Set to true when the query is answered by the cache.
+        \return The cached routes departing in the departure time window of the query.
+        \public
+        A cached Journey which started scanning after the departure time of the query,
+        or stopped before its latest departure time, doesn't answer the query.
+        A cached Journey without routes in the departure time window doesn't answer the query either.
+     */
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes(const QRail::RouterEngine::Query &query, bool *ok = nullptr);
+    //! Adds a Journey to the cache.
+    /*!
+        \param journey The Journey to cache, the stations, departure time and maximum amount of transfers are used as key.
+        \note The routes of the Journey are copied, the Journey itself isn't kept.
+        \public
+        The least recently used Journey is evicted when the cache is full.
+        A cached Journey with the same key is only replaced when it doesn't cover the departure time window of the Journey.
+     */
+    void insert(QRail::RouterEngine::Journey *journey);
+    //! Removes every Journey from the cache.
+    void clear();
+    //! Gets the number of cached Journeys.
+    qint32 size() const;
+    //! Gets the maximum number of cached Journeys.
+    qint32 maxSize() const;
+    //! Sets the maximum number of cached Journeys, 0 disables the cache.
+    void setMaxSize(const qint32 maxSize);
+    //! Gets the size of the departure time buckets in seconds.
+    qint32 bucketSize() const;
+    //! Sets the size of the departure time buckets in seconds.
+    void setBucketSize(const qint32 bucketSize);
+
+public slots:
+    //! Evicts every Journey which scanned the updated page.
+    void invalidatePage(const QUrl &pageURI);
+    //! Evicts every Journey which uses the updated connection.
+    void invalidateFragment(QSharedPointer<QRail::Fragments::Fragment> fragment);
+
+private:
+    struct Entry {
+        QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+        QDateTime departureTime;
+        QDateTime latestDepartureTime;
+        QList<QUrl> dependencies;
+    };
+    QString key(const QUrl &departureStation,
+                const QUrl &arrivalStation,
+                const QDateTime &departureTime,
+                const QDateTime &latestDepartureTime,
+                const qint32 maxTransfers) const;
+    bool covers(const QRail::RouterEngine::JourneyCache::Entry &entry,
+                const QDateTime &departureTime,
+                const QDateTime &latestDepartureTime) const;
+    void invalidate(const QUrl &uri);
+    void remove(const QString &key);
+    mutable QMutex m_mutex;
+    QHash<QString, QRail::RouterEngine::JourneyCache::Entry> m_entries;
+    QList<QString> m_order;
+    QHash<QUrl, QSet<QString> > m_dependents;
+    qint32 m_maxSize;
+    qint32 m_bucketSize;
+};
+}
+}
+
+#endif // ROUTERJOURNEYCACHE_H
@@ -43,6 +43,9 @@
 #include "engines/router/routertransfer.h"
 #include "engines/router/routerjourney.h"
 #include "engines/router/routernulljourney.h"
+#include "engines/router/routerquery.h"
+#include "engines/router/routerjourneycache.h"
+#include "engines/router/routerdestinationcache.h"
 #include "engines/station/stationfactory.h"
 #include "engines/station/stationstation.h"
 #include "fragments/fragmentsfactory.h"
@@ -64,10 +67,18 @@
 #define MILISECONDS_TO_SECONDS_MULTIPLIER 1000 // 1000 miliseconds = 1 second
 #define SECONDS_TO_HOURS_MULTIPLIER 3600       // 3600 seconds = 1 hour
 #define MINIMUM_PROGRESS_INCREMENT 1.0         // 1.0 = 1%
+#define INFINITE_TIME Q_INT64_C(9223372036854775807) // Later than any epoch-second time, marks unreachable arrivals
+#define INFINITE_TRANSFERS 32767               // 16 bits signed 01111111 11111111
+#define DEFAULT_PREFETCH_DEPTH 2               // 2 pages in flight while a page is scanned
+#define FORWARD_SEARCH_SLACK 3600              // 3600 seconds = 1 hour after the earliest arrival
+#define INCREMENTAL_UPDATE_MAX_FRAGMENTS 16    // More updated connections than this always trigger a rollback
+#define UPDATE_COALESCING_INTERVAL 2000        // 2000 ms = 2 s, update batches within this window cause 1 reroute
+#define MINIMUM_UPDATE_RETRY_INTERVAL 500      // 500 ms = 0.5 s, retry interval while the planner is busy
 
 #define SEARCH_RADIUS 3.0                      // 3.0 km
 #define MAX_RESULTS 5                          // 5 results maximum
 #define WALKING_SPEED 5.0                      // 5.0 km/h
+#define MAXIMUM_TRAIN_SPEED 320.0              // 320.0 km/h, faster than any train on the network
 
 // Singleton pattern
 namespace QRail {
@@ -88,19 +99,44 @@ public:
         Constructs a RouterEngine::Planner if none exists and returns the instance.
      */
     static Planner *getInstance(QRail::Network::EventSource::Subscription subscriptionType = QRail::Network::EventSource::Subscription::POLLING);
+    //! QRail::RouterEngine::Planner constructor.
+    /*!
+        \param subscriptionType The subscription type for real time updates.
+        \param parent The parent QObject.
+        \public
+        Constructs a RouterEngine::Planner which isn't shared with the rest of the application.
+        Every planner keeps its own state, the Fragments::Factory and its page cache are shared.
+        \note Use a RouterEngine::PlannerPool to run multiple queries concurrently.
+     */
+    explicit Planner(QRail::Network::EventSource::Subscription subscriptionType, QObject *parent = nullptr);
     //! Retrieves a Journey between 2 given stops.
     /*!
         \param departureStation The URI of the departure stop.
         \param arrivalStation The URI of the arrival stop.
         \param departureTime The requested departure time.
+        \param deadline The maximum processing time in milliseconds, 0 to wait for the complete result.
         \public
         Searches for possible routes between the 2 stops using the CSA.<br>
+        When the deadline is reached, no more pages are fetched and the routes found so far are returned.
+        Such a Journey is marked as partial, see Journey::isPartial.<br>
         In case something goes wrong, a RouterEngine::NullJourney instance is returned.
      */
-    void getConnections(const QUrl &departureStation,
-                        const QUrl &arrivalStation,
-                        const QDateTime &departureTime,
-                        const quint16 &maxTransfers);
+    Q_INVOKABLE void getConnections(const QUrl &departureStation,
+                                    const QUrl &arrivalStation,
+                                    const QDateTime &departureTime,
+                                    const quint16 &maxTransfers,
+                                    const qint32 &deadline = 0);
+    //! Retrieves a Journey for a query.
+    /*!
+        \param query The query you want to plan.
+        \param deadline The maximum processing time in milliseconds, 0 to wait for the complete result.
+        \overload
+        \public
+        Searches for possible routes between the 2 stops of the query using the CSA.<br>
+        Range queries only return the routes departing at or before the latest departure time of the query.
+     */
+    Q_INVOKABLE void getConnections(const QRail::RouterEngine::Query &query,
+                                    const qint32 &deadline = 0);
     //! Retrieves a Journey between 2 given stops.
     /*!
         \param journey A Journey object that you want to reroute.
@@ -115,6 +151,7 @@ public:
         \param departurePosition The GPS location of the departure location.
         \param arrivalPosition The GPS location of the arrival location.
         \param departureTime The requested departure time.
+        \param deadline The maximum processing time in milliseconds, 0 to wait for the complete result.
         \overload
         \note The closest stops are used to plan a journey.
         \public
@@ -124,7 +161,19 @@ public:
     void getConnections(const QGeoCoordinate &departurePosition,
                         const QGeoCoordinate &arrivalPosition,
                         const QDateTime &departureTime,
-                        const quint16 &maxTransfers);
+                        const quint16 &maxTransfers,
+                        const qint32 &deadline = 0);
+    //! Retrieves a Journey for each given query.
+    /*!
+        \param queries The list of queries you want to plan.
+        \overload
+        \note The routes of all the Journeys are emitted through the stream signal.
+        \public
+        Searches for possible routes for all queries using the CSA.<br>
+        Each Linked Connections page is fetched and parsed only once for the whole batch.
+        The batchJourneyFinished signal is emitted for every Journey, followed by the batchFinished signal.
+     */
+    void getConnections(const QList<QRail::RouterEngine::Query> &queries);
     //! Guess the worst case arrival time based on the departure time.
     QDateTime calculateArrivalTime(const QDateTime &departureTime);
     //! Cancels a current operation
@@ -179,9 +228,142 @@ public:
         Sets current Journey.
      */
     void setJourney(QRail::RouterEngine::Journey *journey);
+    //! Checks if the forward Earliest Arrival search is enabled.
+    /*!
+        \return true if the arrival time bound is calculated with a forward Earliest Arrival search.
+        \public
+     */
+    bool isForwardSearchEnabled() const;
+    //! Enables or disables the forward Earliest Arrival search.
+    /*!
+        \param forwardSearchEnabled true to scan the pages forward from the departure time before the profile scan.
+        \note The profile scan starts at the earliest arrival time plus FORWARD_SEARCH_SLACK.
+               When disabled, the arrival time is guessed by calculateArrivalTime.
+        \public
+     */
+    void setForwardSearchEnabled(const bool forwardSearchEnabled);
+    //! Checks if connections are pruned with a geographic lower bound.
+    /*!
+        \return true if connections which can't reach the destination in time are pruned.
+        \public
+     */
+    bool isGeographicPruningEnabled() const;
+    //! Enables or disables the geographic lower bound pruning.
+    /*!
+        \param geographicPruningEnabled true to prune connections using the distance to the destination.
+        \note The lower bound is the straight line distance from a station to the destination at MAXIMUM_TRAIN_SPEED.
+               Connections arriving too late to reach the destination before the arrival time of the Journey are pruned.
+               Stations without a known position are never pruned. Disabled by default.
+        \public
+     */
+    void setGeographicPruningEnabled(const bool geographicPruningEnabled);
+    //! Gets the Journey result cache.
+    /*!
+        \return The RouterEngine::JourneyCache which answers repeated queries.
+        \note Cached Journeys are evicted when one of their pages or connections is updated.
+        \public
+     */
+    QRail::RouterEngine::JourneyCache *journeyCache() const;
+    //! Sets the Journey result cache.
+    /*!
+        \param journeyCache The RouterEngine::JourneyCache which answers repeated queries.
+        \note The cache isn't owned by the Planner, a RouterEngine::PlannerPool shares one cache between its planners.
+               The owner of the cache connects it to the updates of the Fragments::Factory, the Planner doesn't.
+        \public
+     */
+    void setJourneyCache(QRail::RouterEngine::JourneyCache *journeyCache);
+    //! Gets the destination profile cache.
+    /*!
+        \return The RouterEngine::DestinationCache which answers queries towards recent destinations.
+        \public
+     */
+    QRail::RouterEngine::DestinationCache *destinationCache() const;
+    //! Sets the destination profile cache.
+    /*!
+        \param destinationCache The RouterEngine::DestinationCache which answers queries towards recent destinations.
+        \note The cache isn't owned by the Planner, a RouterEngine::PlannerPool shares one cache between its planners.
+        \public
+     */
+    void setDestinationCache(QRail::RouterEngine::DestinationCache *destinationCache);
+    //! Gets the size of the destination profile cache.
+    /*!
+        \return The maximum number of destinations for which the profiles are kept.
+        \public
+     */
+    qint32 destinationCacheSize() const;
+    //! Sets the size of the destination profile cache.
+    /*!
+        \param destinationCacheSize The maximum number of destinations for which the profiles are kept.
+        \note A query towards a cached destination is answered without fetching any page when its
+               time window is covered by the cached profiles. A size of 0 disables the cache.
+        \public
+     */
+    void setDestinationCacheSize(const qint32 destinationCacheSize);
+    //! Gets the update coalescing interval.
+    /*!
+        \return The window in milliseconds during which real time update batches are merged.
+        \public
+     */
+    qint32 updateCoalescingInterval() const;
+    //! Sets the update coalescing interval.
+    /*!
+        \param updateCoalescingInterval The window in milliseconds during which real time update batches are merged.
+        \note The Journey is rerouted at most once per window. A window of 0 processes every update batch right away.
+        \public
+     */
+    void setUpdateCoalescingInterval(const qint32 updateCoalescingInterval);
+    //! Checks if real time updates are applied incrementally.
+    /*!
+        \return true if small updates are applied to the routes without rescanning the pages.
+        \public
+     */
+    bool isIncrementalUpdatesEnabled() const;
+    //! Enables or disables incremental real time updates.
+    /*!
+        \param incrementalUpdatesEnabled true to apply small updates to the routes directly.
+        \note Updated routes are new Route objects which are emitted through the stream signal,
+               routes whose times didn't change are kept as they are.
+               When an update makes a transfer impossible, delays the arrival of a route or affects more than
+               INCREMENTAL_UPDATE_MAX_FRAGMENTS connections, the Journey is rolled back and rerouted instead.
+        \public
+     */
+    void setIncrementalUpdatesEnabled(const bool incrementalUpdatesEnabled);
+    //! Checks if the Planner reroutes its Journey in the background.
+    /*!
+        \return true if real time updates and the polling timer reroute the current Journey.
+        \public
+     */
+    bool isBackgroundUpdatesEnabled() const;
+    //! Enables or disables background reroutes of the current Journey.
+    /*!
+        \param backgroundUpdatesEnabled false to only run the queries which are requested.
+        \note Disable them when the Planner only answers queries for someone else, like the planners
+               of a RouterEngine::PlannerPool. A background reroute emits finished and keeps the Planner busy.
+        \public
+     */
+    void setBackgroundUpdatesEnabled(const bool backgroundUpdatesEnabled);
+    //! Gets the prefetch depth of the Planner.
+    /*!
+        \return The number of previous pages which are fetched while a page is scanned.
+        \public
+     */
+    quint16 prefetchDepth() const;
+    //! Sets the prefetch depth of the Planner.
+    /*!
+        \param prefetchDepth The number of previous pages which are fetched while a page is scanned.
+        \note A depth of 0 disables prefetching, pages are fetched one by one after scanning.
+        \public
+     */
+    void setPrefetchDepth(const quint16 prefetchDepth);
     //! Test purposes
     QRail::Fragments::Factory *fragmentsFactory() const;
     //! Watch a Journey for updates
+    /*!
+        \param journey The Journey you want to watch.
+        \note The connections of the routes are indexed, updates of these connections are reported through the watchedJourneyUpdated signal.
+               The current Journey of the Planner is always watched.
+        \public
+     */
     void watch(QRail::RouterEngine::Journey *journey);
     //! Unwatch a Journey for updates
     void unwatch(QRail::RouterEngine::Journey *journey);
@@ -203,6 +385,14 @@ signals:
     void requested(const QUrl &pageURI);
     //! Emitted when a new Fragments::Page has been received.
     void processing(const QUrl &pageURI);
+    //! Emitted when the Earliest Arrival filter removed the unreachable connections of a Fragments::Page.
+    void pruned(const QUrl &pageURI, const qint32 prunedConnections);
+    //! Emitted when the Journey of a query in a batch is finished.
+    void batchJourneyFinished(const qint32 queryIndex, QRail::RouterEngine::Journey *journey);
+    //! Emitted when all the Journeys of a batch are finished or the batch has been aborted.
+    void batchFinished();
+    //! Emitted when a connection used by a watched Journey has been updated.
+    void watchedJourneyUpdated(QRail::RouterEngine::Journey *journey, QSharedPointer<QRail::Fragments::Fragment> fragment);
     void updateReceived(qint64 time);
     void updateProcessed();
     void startReroute();
@@ -210,31 +400,84 @@ signals:
 private slots:
     void unlockPlanner();
     void handleTimeout();
+    void handleDeadline();
     void handleFragmentFactoryError();
     void handleFragmentAndPageFactoryUpdate(QSharedPointer<QRail::Fragments::Fragment> fragment, QUrl pageURI);
+    void handleJourneyDestroyed(QObject *object);
+    void scheduleUpdate();
     void processUpdate();
-    void processPage(QSharedPointer<QRail::Fragments::Page> page);
+    void processPage(QSharedPointer<QRail::Fragments::Page> page, QObject *caller, quint64 requestID);
     void reroute();
 
 private:
     QTimer *m_timer;
     QRail::Network::EventSource::Subscription m_subscriptionType;
     bool m_isRunning;
+    quint64 m_queryGeneration;
     QUrl pageUpdateURI;
     QDateTime fragmentUpdateTimestamp;
+    QUrl incrementalUpdatePageURI;
+    QDateTime incrementalUpdateTimestamp;
+    QHash<QUrl, QSharedPointer<QRail::Fragments::Fragment> > m_updatedFragments;
+    bool m_incrementalUpdatesEnabled;
+    bool m_backgroundUpdatesEnabled;
     QList<QRail::RouterEngine::Journey *> m_watchList;
+    struct WatchedLeg {
+        QRail::RouterEngine::Journey *journey;
+        QSharedPointer<QRail::RouterEngine::Route> route;
+        QSharedPointer<QRail::RouterEngine::RouteLeg> leg;
+    };
+    QHash<QUrl, QList<QRail::RouterEngine::Planner::WatchedLeg> > m_watchIndex;
+    QHash<QRail::RouterEngine::Journey *, QList<QUrl> > m_watchedURIs;
+    QHash<QRail::RouterEngine::Journey *, QList<QUrl> > m_pinnedPages;
+    QRail::RouterEngine::DestinationCache *m_destinationCache;
+    QRail::RouterEngine::JourneyCache *m_journeyCache;
     QTimer *progressTimeoutTimer;
+    QTimer *updateCoalescingTimer;
+    QTimer *deadlineTimer;
+    qint32 m_updateCoalescingInterval;
     mutable QMutex plannerProcessingMutex;
     mutable QMutex syncThreadMutex;
     QRail::Fragments::Factory *m_fragmentsFactory;
     StationEngine::Factory *m_stationFactory;
     QRail::RouterEngine::Journey *m_journey;
     QList<QSharedPointer<QRail::Fragments::Page>> m_usedPages;
+    QList<QRail::RouterEngine::Journey *> m_batchJourneys;
+    QVector<bool> m_batchFinished;
     bool m_abortRequested;
-    explicit Planner(QRail::Network::EventSource::Subscription subscriptionType, QObject *parent = nullptr);
+    quint16 m_prefetchDepth;
+    bool m_forwardSearchEnabled;
+    bool m_geographicPruningEnabled;
+    QHash<quint32, QVector<qint64> > m_lowerBounds;
+    QHash<quint32, QGeoCoordinate> m_stationPositions;
+    bool m_forwardSearch;
+    QVector<qint64> m_forwardArrivalTimes;
+    QVector<bool> m_forwardReachedTrips;
     static QRail::RouterEngine::Planner *m_instance;
     void parsePage(QSharedPointer<QRail::Fragments::Page> page);
-    QSharedPointer<StationStopProfile> getFirstReachableConnection(QSharedPointer<StationStopProfile> arrivalProfile);
+    void requestPage(const QUrl &uri);
+    void requestPage(const QDateTime &departureTime);
+    void prefetchPages(const QUrl &uri, QRail::Fragments::Factory::Direction direction);
+    void processForwardPage(QSharedPointer<QRail::Fragments::Page> page);
+    void startProfileScan();
+    QDateTime forwardSearchDepartureTime() const;
+    bool applyIncrementalUpdate();
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> updateRouteLegEnd(const QSharedPointer<QRail::RouterEngine::RouteLegEnd> &legEnd, const bool isDeparture) const;
+    void indexJourney(QRail::RouterEngine::Journey *journey);
+    void unindexJourney(QRail::RouterEngine::Journey *journey);
+    void parseBatchPage(QSharedPointer<QRail::Fragments::Page> page);
+    void finishBatch();
+    bool isBatchRunning() const;
+    QRail::RouterEngine::Journey *createJourney(const QRail::RouterEngine::Query &query);
+    bool scanPage(QSharedPointer<QRail::Fragments::Page> page, QRail::RouterEngine::Journey *journey, bool &hasPassedDepartureTimeLimit);
+    void finishJourney();
+    const QVector<qint64> &lowerBounds(const quint32 arrivalStationID);
+    QGeoCoordinate stationPosition(const quint32 stationID);
+    void cacheDestinationProfile(QRail::RouterEngine::Journey *journey);
+    bool answerFromDestinationCache();
+    void extractRoutes(QRail::RouterEngine::Journey *journey, const quint32 departureStationID, const quint32 arrivalStationID);
+    QSharedPointer<QRail::RouterEngine::RouteLeg> createRouteLeg(QSharedPointer<QRail::RouterEngine::StationStopProfile> profile);
+    QSharedPointer<StationStopProfile> getFirstReachableConnection(QRail::RouterEngine::Journey *journey, QSharedPointer<StationStopProfile> arrivalProfile);
     void setFragmentsFactory(QRail::Fragments::Factory *value);
     StationEngine::Factory *stationFactory() const;
     void setStationFactory(StationEngine::Factory *stationFactory);
@@ -0,0 +1,173 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERPLANNERPOOL_H
+#define ROUTERPLANNERPOOL_H
+
+#include <QtCore/QObject>
+#include <QtCore/QList>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QDebug>
+
+#include "engines/router/routerplanner.h"
+#include "engines/router/routerjourneycache.h"
+#include "engines/router/routerdestinationcache.h"
+#include "engines/router/routerquery.h"
+#include "engines/router/routerjourney.h"
+#include "engines/router/routernulljourney.h"
+#include "engines/router/routerroute.h"
+#include "qrail.h"
+
+namespace QRail {
+namespace RouterEngine {
+//! A RouterEngine::PlannerPool runs multiple RouterEngine::Planner queries concurrently.
+/*!
+    \class PlannerPool
+    Each RouterEngine::Planner of the pool lives in its own worker thread and keeps its own Journey state.
+    The planners of the pool don't reroute in the background, they only run the queries dispatched by the pool.
+    The Fragments::Factory, its page cache, the RouterEngine::JourneyCache and the RouterEngine::DestinationCache are shared by all planners.
+    Queries are queued when every planner is busy and dispatched as soon as a planner becomes idle.
+ */
+class QRAIL_SHARED_EXPORT PlannerPool : public QObject
+{
+    Q_OBJECT
+public:
+    //! Gets a RouterEngine::PlannerPool instance.
+    /*!
+        \param subscriptionType The subscription type for real time updates.
+        \return An instance of RouterEngine::PlannerPool.
+        \public
+        Constructs a RouterEngine::PlannerPool with one planner per CPU core if none exists and returns the instance.
+     */
+    static PlannerPool *getInstance(QRail::Network::EventSource::Subscription subscriptionType = QRail::Network::EventSource::Subscription::POLLING);
+    //! Gets the Journey result cache shared by the planners of the pool.
+    /*!
+        \return The RouterEngine::JourneyCache which answers repeated queries.
+        \public
+     */
+    QRail::RouterEngine::JourneyCache *journeyCache() const;
+    //! Gets the destination profile cache shared by the planners of the pool.
+    /*!
+        \return The RouterEngine::DestinationCache which answers queries towards recent destinations.
+        \public
+     */
+    QRail::RouterEngine::DestinationCache *destinationCache() const;
+    //! RouterEngine::PlannerPool destructor.
+    /*!
+        \public
+        Stops all worker threads of the pool.
+     */
+    ~PlannerPool();
+    //! Retrieves a Journey between 2 given stops.
+    /*!
+        \param departureStation The URI of the departure stop.
+        \param arrivalStation The URI of the arrival stop.
+        \param departureTime The requested departure time.
+        \param maxTransfers The maximum amount of transfers.
+        \public
+        Queues the query and runs it on the first idle RouterEngine::Planner.<br>
+        The result is emitted through the finished signal, use the Journey to match it with the query.
+     */
+    void getConnections(const QUrl &departureStation,
+                        const QUrl &arrivalStation,
+                        const QDateTime &departureTime,
+                        const quint16 &maxTransfers);
+    //! Retrieves all routes between 2 given stops departing in a time window.
+    /*!
+        \param departureStation The URI of the departure stop.
+        \param arrivalStation The URI of the arrival stop.
+        \param departureTime The start of the departure time window.
+        \param latestDepartureTime The end of the departure time window, routes departing at this time are included.
+        \param maxTransfers The maximum amount of transfers.
+        \param slices The number of slices, 0 to use one slice per planner of the pool.
+        \public
+        The departure time window is split into slices which are planned as independent range queries
+        on the planners of the pool. Each slice scans from its own arrival time bound, based on the end of the slice.
+        The Pareto optimal routes of all slices are merged into one Journey which is emitted through the finished signal.
+     */
+    void getConnections(const QUrl &departureStation,
+                        const QUrl &arrivalStation,
+                        const QDateTime &departureTime,
+                        const QDateTime &latestDepartureTime,
+                        const quint16 &maxTransfers,
+                        const qint32 slices = 0);
+    //! Gets the number of planners in the pool.
+    /*!
+        \return The number of planners, each planner runs one query at a time.
+        \public
+     */
+    qint32 size() const;
+    //! Gets the number of queries waiting for an idle planner.
+    /*!
+        \return The number of queued queries.
+        \public
+     */
+    qint32 pendingQueries() const;
+    //! Filters the Pareto optimal routes.
+    /*!
+        \param routes The routes of the slices of a range query.
+        \return The routes which aren't dominated by another route, sorted by departure time.
+        \public
+        A route is dominated by a route departing at the same time or later which arrives at the same time or earlier
+        with the same or less transfers, and is better in at least one of them.
+     */
+    static QList<QSharedPointer<QRail::RouterEngine::Route> > paretoRoutes(const QList<QSharedPointer<QRail::RouterEngine::Route> > &routes);
+
+signals:
+    //! Emitted when the Journey calculation of a query is finished.
+    void finished(QRail::RouterEngine::Journey *journey);
+    //! Emitted when a route has been found for a query.
+    void stream(QSharedPointer<QRail::RouterEngine::Route> route);
+    //! Emitted when something goes wrong.
+    void error(const QString &message);
+
+private slots:
+    void handlePlannerFinished(QRail::RouterEngine::Journey *journey);
+
+private:
+    explicit PlannerPool(QRail::Network::EventSource::Subscription subscriptionType, const qint32 size, QObject *parent = nullptr);
+    static QRail::RouterEngine::PlannerPool *m_instance;
+    mutable QMutex m_poolMutex;
+    QList<QThread *> m_threads;
+    QRail::RouterEngine::JourneyCache *m_journeyCache;
+    QRail::RouterEngine::DestinationCache *m_destinationCache;
+    QList<QRail::RouterEngine::Planner *> m_planners;
+    QList<QRail::RouterEngine::Planner *> m_idlePlanners;
+    struct Task {
+        QRail::RouterEngine::Query query;
+        qint32 rangeID;
+    };
+    struct Range {
+        QRail::RouterEngine::Query query;
+        QList<QRail::RouterEngine::Journey *> journeys;
+        qint32 remainingSlices;
+    };
+    QList<QRail::RouterEngine::PlannerPool::Task> m_pendingTasks;
+    QHash<QRail::RouterEngine::Planner *, QRail::RouterEngine::PlannerPool::Task> m_runningTasks;
+    QHash<qint32, QRail::RouterEngine::PlannerPool::Range> m_ranges;
+    qint32 m_nextRangeID;
+    void schedule(const QRail::RouterEngine::Query &query, const qint32 rangeID);
+    void dispatch(QRail::RouterEngine::Planner *planner, const QRail::RouterEngine::PlannerPool::Task &task);
+    QRail::RouterEngine::Journey *mergeRange(const QRail::RouterEngine::PlannerPool::Range &range);
+};
+}
+}
+
+#endif // ROUTERPLANNERPOOL_H
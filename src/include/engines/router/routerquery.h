@@ -0,0 +1,108 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERQUERY_H
+#define ROUTERQUERY_H
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QUrl>
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QMetaType>
+
+namespace QRail {
+namespace RouterEngine {
+//! A RouterEngine::Query holds the parameters of a single routing request.
+/*!
+    \class Query
+    Queries are used to plan multiple journeys in one run of the RouterEngine::Planner.
+ */
+class Query
+{
+public:
+    //! QRail::RouterEngine::Query constructor: empty.
+    /*!
+        \public
+        Constructs an invalid QRail::RouterEngine::Query.
+     */
+    Query();
+    //! QRail::RouterEngine::Query constructor: full.
+    /*!
+        \param departureStation The URI of the departure stop.
+        \param arrivalStation The URI of the arrival stop.
+        \param departureTime The requested departure time.
+        \param maxTransfers The maximum amount of transfers.
+        \param latestDepartureTime Only routes departing at or before this time are returned, invalid for no limit.
+        \public
+        Constructs a QRail::RouterEngine::Query with the given parameters.
+     */
+    Query(const QUrl &departureStation,
+          const QUrl &arrivalStation,
+          const QDateTime &departureTime,
+          const quint16 &maxTransfers,
+          const QDateTime &latestDepartureTime = QDateTime());
+    //! Gets the departure station URI of the Query.
+    QUrl departureStation() const;
+    //! Gets the arrival station URI of the Query.
+    QUrl arrivalStation() const;
+    //! Gets the requested departure time of the Query.
+    QDateTime departureTime() const;
+    //! Gets the latest departure time of the Query.
+    /*!
+        \return The end of the departure time window, invalid if the Query isn't a range query.
+        \public
+     */
+    QDateTime latestDepartureTime() const;
+    //! Gets the maximum amount of transfers of the Query.
+    quint16 maxTransfers() const;
+    //! Checks if the Query can be planned.
+    /*!
+        \return true if the stations and the departure time are valid and the departure time window isn't empty.
+        \public
+     */
+    bool isValid() const;
+    //! Checks if a departure time falls in the departure time window of the Query.
+    /*!
+        \param departureTime The departure time of a route.
+        \return true if the route departs after the requested departure time and at or before the latest departure time.
+        \public
+        The requested departure time is exclusive, the latest departure time is inclusive.
+        Routes departing exactly on the boundary between 2 slices belong to the earlier slice.
+     */
+    bool isInDepartureWindow(const QDateTime &departureTime) const;
+    //! Splits the departure time window of the Query into slices.
+    /*!
+        \param count The number of slices.
+        \return The consecutive slices of the departure time window, each slice starts where the previous one ends.
+        \public
+        Every departure time in the window of the Query is part of exactly one slice.
+        A Query without a latest departure time isn't split.
+     */
+    QList<QRail::RouterEngine::Query> slices(const qint32 count) const;
+
+private:
+    QUrl m_departureStation;
+    QUrl m_arrivalStation;
+    QDateTime m_departureTime;
+    QDateTime m_latestDepartureTime;
+    quint16 m_maxTransfers;
+};
+}
+}
+
+Q_DECLARE_METATYPE(QRail::RouterEngine::Query)
+
+#endif // ROUTERQUERY_H
@@ -18,7 +18,7 @@
 #define ROUTERCACHEDJOURNEY_H
 
 #include <QtCore/QObject>
-#include <QtCore/QMap>
+#include <QtCore/QVector>
 #include <QtCore/QUrl>
 #include <QtCore/QUrlQuery>
 #include <QtCore/QDateTime>
@@ -31,40 +31,69 @@
 
 namespace QRail {
 namespace RouterEngine {
+//! A RouterEngine::SnapshotJourney records the changes a Linked Connections page made to a Journey.
+/*!
+    \class SnapshotJourney
+    Instead of copying the complete state of the Journey after every page, only the previous values
+    of the modified entries are kept. The Journey can be rolled back to the state before a page
+    by replaying the snapshots backwards, see Journey::restoreBeforePage.
+ */
 class SnapshotJourney : public QObject
 {
     Q_OBJECT
 public:
-    //! Constructs a SnapshotJourney object with all the needed parameters.
+    //! The kind of change recorded in a SnapshotJourney.
+    enum class ChangeType {
+        T_EARLIEST_ARRIVAL_TIME,
+        S_EARLIEST_ARRIVAL_TIME,
+        T_ARRAY,
+        S_ARRAY_APPEND,
+        S_ARRAY_REPLACE_LAST
+    };
+    //! A single change, holding the value before the change.
+    struct Change {
+        QRail::RouterEngine::SnapshotJourney::ChangeType type;
+        quint32 index;
+        qint64 time;
+        QSharedPointer<QRail::RouterEngine::TrainProfile> trainProfile;
+        QSharedPointer<QRail::RouterEngine::StationStopProfile> stationStopProfile;
+    };
+    //! Constructs an empty SnapshotJourney for a Linked Connections page.
     explicit SnapshotJourney(QUrl pageURI,
                            QUrl hydraNext,
                            QUrl hydraPrevious,
-                           QList<QSharedPointer<QRail::RouterEngine::Route >> routes,
-                           QMap<QUrl, qint16> T_EarliestArrivalTime,
-                           QMap<QUrl, QDateTime> S_EarliestArrivalTime,
-                           QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray,
-                           QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > TArray,
                            QObject *parent = nullptr);
     QUrl pageURI() const;
     QUrl hydraNext() const;
     QUrl hydraPrevious() const;
-    QList<QSharedPointer<QRail::RouterEngine::Route >> routes() const;
-    QMap<QUrl, qint16> T_EarliestArrivalTime() const;
-    QMap<QUrl, QDateTime> S_EarliestArrivalTime() const;
-    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > SArray() const;
-    QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > TArray() const;
     QDateTime pageTimestamp() const;
+    //! Gets the recorded changes in the order they were made.
+    const QVector<QRail::RouterEngine::SnapshotJourney::Change> &changes() const;
+    //! Gets the routes before the page, only valid if hasRoutes() returns true.
+    QList<QSharedPointer<QRail::RouterEngine::Route >> routes() const;
+    //! Checks if the routes were modified by the page.
+    bool hasRoutes() const;
+    //! Records the previous T earliest arrival counter of a trip.
+    void recordT_EarliestArrivalTime(const quint32 tripID, const qint16 count);
+    //! Records the previous S earliest arrival time of a station.
+    void recordS_EarliestArrivalTime(const quint32 stationID, const qint64 earliestArrivalTime);
+    //! Records the previous TrainProfile of a trip.
+    void recordTArray(const quint32 tripID, const QSharedPointer<QRail::RouterEngine::TrainProfile> &trainProfile);
+    //! Records a StationStopProfile appended to the S array of a station.
+    void recordSArrayAppend(const quint32 stationID);
+    //! Records the previous last StationStopProfile of the S array of a station.
+    void recordSArrayReplaceLast(const quint32 stationID, const QSharedPointer<QRail::RouterEngine::StationStopProfile> &stationStopProfile);
+    //! Records the routes before the page, only the first call has an effect.
+    void recordRoutes(const QList<QSharedPointer<QRail::RouterEngine::Route >> &routes);
 
 private:
     QUrl m_pageURI;
     QUrl m_hydraNext;
     QUrl m_hydraPrevious;
     QDateTime m_pageTimestamp;
+    QVector<QRail::RouterEngine::SnapshotJourney::Change> m_changes;
     QList<QSharedPointer<QRail::RouterEngine::Route >> m_routes;
-    QMap<QUrl, qint16> m_T_EarliestArrivalTime;
-    QMap<QUrl, QDateTime> m_S_EarliestArrivalTime;
-    QMap<QUrl, QList<QSharedPointer<QRail::RouterEngine::StationStopProfile> > > m_SArray;
-    QMap<QUrl, QSharedPointer<QRail::RouterEngine::TrainProfile> > m_TArray;
+    bool m_hasRoutes;
 };
 }}
 
@@ -17,29 +17,33 @@
 #ifndef CSASTATIONSTOPPROFILE_H
 #define CSASTATIONSTOPPROFILE_H
 
-#include <QtCore/QObject>
-#include <QtCore/QDateTime>
+#include <QtCore/QtGlobal>
 #include <QtCore/QSharedPointer>
 #include "fragments/fragmentsfragment.h"
 
 namespace QRail {
 namespace RouterEngine {
-class StationStopProfile : public QObject
+//! A RouterEngine::StationStopProfile is an entry of the S array in the Connection Scan Algorithm.
+/*!
+    \class StationStopProfile
+    Profiles are created with QSharedPointer::create(), the object and its reference count share one allocation.
+    They are shared by the S array, the undo snapshots, the destination profile cache and the extracted routes,
+    so they aren't allocated per Journey and live as long as one of them uses them.
+ */
+class StationStopProfile
 {
-    Q_OBJECT
 public:
     explicit StationStopProfile(
-        const QDateTime &departureTime,
-        const QDateTime &arrivalTime,
+        const qint64 departureTime,
+        const qint64 arrivalTime,
         QSharedPointer<QRail::Fragments::Fragment> departureConnection,
         QSharedPointer<QRail::Fragments::Fragment> arrivalConnection,
-        const qint16 transfers,
-        QObject *parent = nullptr
+        const qint16 transfers
     );
-    QDateTime departureTime() const;
-    void setDepartureTime(const QDateTime &departureTime);
-    QDateTime arrivalTime() const;
-    void setArrivalTime(const QDateTime &arrivalTime);
+    qint64 departureTime() const;
+    void setDepartureTime(const qint64 departureTime);
+    qint64 arrivalTime() const;
+    void setArrivalTime(const qint64 arrivalTime);
     QSharedPointer<QRail::Fragments::Fragment> departureConnection() const;
     void setDepartureConnection(QSharedPointer<QRail::Fragments::Fragment> departureConnection);
     QSharedPointer<QRail::Fragments::Fragment> arrivalConnection() const;
@@ -47,16 +51,9 @@ public:
     qint16 transfers() const;
     void setTransfers(const qint16 &transfers);
 
-signals:
-    void departureTimeChanged();
-    void arrivalTimeChanged();
-    void departureConnectionChanged();
-    void arrivalConnectionChanged();
-    void transfersChanged();
-
 private:
-    QDateTime m_departureTime;
-    QDateTime m_arrivalTime;
+    qint64 m_departureTime;
+    qint64 m_arrivalTime;
     QSharedPointer<QRail::Fragments::Fragment> m_departureConnection;
     QSharedPointer<QRail::Fragments::Fragment> m_arrivalConnection;
     qint16 m_transfers;
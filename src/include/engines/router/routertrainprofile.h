@@ -17,37 +17,35 @@
 #ifndef CSATRAINPROFILE_H
 #define CSATRAINPROFILE_H
 
-#include <QtCore/QObject>
-#include <QtCore/QDateTime>
+#include <QtCore/QtGlobal>
 #include <QtCore/QSharedPointer>
 #include "fragments/fragmentsfragment.h"
 
 namespace QRail {
 namespace RouterEngine {
-class TrainProfile : public QObject
+//! A RouterEngine::TrainProfile is an entry of the T array in the Connection Scan Algorithm.
+/*!
+    \class TrainProfile
+    Profiles are created with QSharedPointer::create() and shared with the undo snapshots,
+    see RouterEngine::StationStopProfile.
+ */
+class TrainProfile
 {
-    Q_OBJECT
 public:
     explicit TrainProfile(
-        const QDateTime &arrivalTime,
+        const qint64 arrivalTime,
         QSharedPointer<QRail::Fragments::Fragment> arrivalConnection,
-        const qint16 transfers,
-        QObject *parent = nullptr
+        const qint16 transfers
     );
-    QDateTime arrivalTime() const;
-    void setArrivalTime(const QDateTime &arrivalTime);
+    qint64 arrivalTime() const;
+    void setArrivalTime(const qint64 arrivalTime);
     QSharedPointer<QRail::Fragments::Fragment> arrivalConnection() const;
     void setArrivalConnection(QSharedPointer<QRail::Fragments::Fragment> arrivalConnection);
     qint16 transfers() const;
     void setTransfers(const qint16 &transfers);
 
-signals:
-    void arrivalTimeChanged();
-    void arrivalConnectionChanged();
-    void transfersChanged();
-
 private:
-    QDateTime m_arrivalTime;
+    qint64 m_arrivalTime;
     QSharedPointer<QRail::Fragments::Fragment> m_arrivalConnection;
     qint16 m_transfers;
 };
@@ -24,6 +24,9 @@
 #include <QtCore/QStringList>
 #include <QtCore/QUrl>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QFuture>
@@ -111,6 +114,7 @@ public:
 private:
     QRail::Database::Manager *m_db;
     QMap<QUrl, QSharedPointer<StationEngine::Station>> m_cache;
+    mutable QReadWriteLock m_cacheLock;
     bool initDatabase();
     bool insertStationWithFacilitiesIntoDatabase(const QStringList &station, const QStringList &facilities);
     bool insertStationWithoutFacilitiesIntoDatabase(const QStringList &station);
@@ -19,21 +19,20 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
 #include <QtCore/QUrl>
 #include <QtCore/QUrlQuery>
-#include <QtCore/QFile>
-#include <QtCore/QFileInfo>
 #include <QtCore/QDir>
-#include <QtCore/QDirIterator>
 #include <QtCore/QStandardPaths>
-#include <QtCore/QJsonObject>
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonArray>
+#include <QtCore/QThread>
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include "fragments/fragmentspage.h"
 #include "fragments/fragmentsfragment.h"
+#include "fragments/fragmentspagestore.h"
+#include "fragments/fragmentspagewriter.h"
 #define MAX_COST 24*60*50*1000 // Allocate space for 50 Kb pages (24 hours, 60 pages/hour) = 72 Mb RAM
-#define PAGE_FILE_NAME "/page.jsonld"
+#define PAGE_STORE_FILE_NAME "/pages.segment"
 
 namespace QRail {
 namespace Fragments {
@@ -42,19 +41,73 @@ class Cache : public QObject
     Q_OBJECT
 public:
     explicit Cache(QObject *parent = nullptr);
+    ~Cache();
     void cachePage(QSharedPointer<QRail::Fragments::Page> page);
     QUrl updateFragment(QSharedPointer<QRail::Fragments::Fragment> fragment);
     QSharedPointer<QRail::Fragments::Page> getPageByURI(QUrl uri);
     QSharedPointer<QRail::Fragments::Page> getPageByFragment(QSharedPointer<QRail::Fragments::Fragment> fragment);
+    QSharedPointer<QRail::Fragments::Page> getPageByTime(const QDateTime &time);
+    QList<QSharedPointer<QRail::Fragments::Page>> getPagesBetween(const QDateTime &from, const QDateTime &until);
     bool hasPage(QUrl uri);
     bool isEmpty();
+    //! Pins pages in memory, pinned pages are never evicted. Pins are counted.
+    Q_INVOKABLE void pinPages(const QList<QUrl> &uris);
+    //! Releases pins taken through pinPages.
+    Q_INVOKABLE void unpinPages(const QList<QUrl> &uris);
+    //! The estimated memory usage of the pages in memory in bytes.
+    qint64 cost() const;
+    //! The memory budget in bytes, pages are evicted to disk when it's exceeded.
+    qint64 maxCost() const;
+    void setMaxCost(const qint64 maxCost);
+    //! The number of pages served from memory.
+    quint64 hits() const;
+    //! The number of pages loaded from disk.
+    quint64 diskHits() const;
+    //! The number of requests which couldn't be served from memory nor disk.
+    quint64 misses() const;
+    //! The number of pages evicted from memory.
+    quint64 evictions() const;
+
+public slots:
+    void flush();
 
 private:
+    // A page covers the departure times [start, end), end is the timestamp of the next page
+    struct PageInterval {
+        QDateTime start;
+        QDateTime end;
+        QUrl uri;
+    };
+    // Memory usage of a page and its CLOCK reference bit
+    struct CacheEntry {
+        qint64 cost;
+        bool referenced;
+    };
     QMap<QUrl, QSharedPointer<QRail::Fragments::Page>> m_cache;
+    QHash<QUrl, QRail::Fragments::Cache::CacheEntry> m_entries;
+    QList<QUrl> m_clock;
+    qint32 m_clockHand;
+    QHash<QUrl, qint32> m_pins;
+    qint64 m_cost;
+    qint64 m_maxCost;
+    quint64 m_hits;
+    quint64 m_diskHits;
+    quint64 m_misses;
+    quint64 m_evictions;
+    QMap<QDateTime, QRail::Fragments::Cache::PageInterval> m_pageIndex;
+    void insertPage(QSharedPointer<QRail::Fragments::Page> page);
+    QSharedPointer<QRail::Fragments::Page> copyPage(QSharedPointer<QRail::Fragments::Page> page,
+                                                    const QList<QSharedPointer<QRail::Fragments::Fragment>> &fragments) const;
+    QSharedPointer<QRail::Fragments::Page> lookupPage(const QUrl &uri);
+    void evictPages();
+    qint64 pageCost(QSharedPointer<QRail::Fragments::Page> page) const;
+    void indexDisk();
+    QDateTime pageTime(const QUrl &uri) const;
     QSharedPointer<QRail::Fragments::Page> getPageFromDisk(QUrl uri);
     QDir m_cacheDir;
-    QJsonValue convertGTFSTypeToJson(QRail::Fragments::Fragment::GTFSTypes type);
-    QRail::Fragments::Fragment::GTFSTypes convertJsonToGTFSType(QJsonValue type);
+    QRail::Fragments::PageStore *m_store;
+    QRail::Fragments::PageWriter *m_writer;
+    QThread *m_writerThread;
 };
 }
 }
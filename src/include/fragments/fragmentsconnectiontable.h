@@ -0,0 +1,116 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSCONNECTIONTABLE_H
+#define FRAGMENTSCONNECTIONTABLE_H
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QSharedPointer>
+#include "fragments/fragmentsfragment.h"
+
+namespace QRail {
+namespace Fragments {
+//! A Fragments::ConnectionTable holds the connections of a page in a columnar layout.
+/*!
+    \class ConnectionTable
+    The Profile Connection Scan Algorithm only needs a couple of fields of each connection.
+    Instead of calling the getters of a Fragments::Fragment for every scanned connection,
+    the fields are copied once into flat columns which are indexed by the position of the connection in its page.
+    The original Fragments::Fragment is kept as a back-reference for the journey extraction.
+ */
+class ConnectionTable
+{
+public:
+    //! Constructs a Fragments::ConnectionTable.
+    /*!
+        \param fragments The fragments of the page, sorted by ASCENDING departure time.
+        \public
+        Constructs a Fragments::ConnectionTable and fills the columns with the fields of the given fragments.
+     */
+    explicit ConnectionTable(const QList<QSharedPointer<QRail::Fragments::Fragment> > &fragments);
+    //! Gets the number of connections in the table.
+    /*!
+        \return The number of rows of the table.
+        \public
+     */
+    qint32 size() const;
+    //! Gets the departure station identifiers column.
+    /*!
+        \return The departure station identifiers of the Fragments::URIIndex.
+        \public
+     */
+    const QVector<quint32> &departureStationIDs() const;
+    //! Gets the arrival station identifiers column.
+    /*!
+        \return The arrival station identifiers of the Fragments::URIIndex.
+        \public
+     */
+    const QVector<quint32> &arrivalStationIDs() const;
+    //! Gets the trip identifiers column.
+    /*!
+        \return The trip identifiers of the Fragments::URIIndex.
+        \public
+     */
+    const QVector<quint32> &tripIDs() const;
+    //! Gets the departure times column.
+    /*!
+        \return The departure times in seconds since the UNIX epoch.
+        \public
+     */
+    const QVector<qint64> &departureTimes() const;
+    //! Gets the arrival times column.
+    /*!
+        \return The arrival times in seconds since the UNIX epoch.
+        \public
+     */
+    const QVector<qint64> &arrivalTimes() const;
+    //! Gets the pickup types column.
+    /*!
+        \return The Fragments::Fragment::GTFSTypes of the pickup in the departure station as bytes.
+        \public
+     */
+    const QVector<quint8> &pickupTypes() const;
+    //! Gets the drop off types column.
+    /*!
+        \return The Fragments::Fragment::GTFSTypes of the drop off in the arrival station as bytes.
+        \public
+     */
+    const QVector<quint8> &dropOffTypes() const;
+    //! Gets the Fragments::Fragment of a row.
+    /*!
+        \param row The row in the table.
+        \return The original Fragments::Fragment of the connection.
+        \public
+        Only needed when the connection is stored in a profile for the journey extraction.
+     */
+    QSharedPointer<QRail::Fragments::Fragment> fragment(const qint32 row) const;
+
+private:
+    QVector<quint32> m_departureStationIDs;
+    QVector<quint32> m_arrivalStationIDs;
+    QVector<quint32> m_tripIDs;
+    QVector<qint64> m_departureTimes;
+    QVector<qint64> m_arrivalTimes;
+    QVector<quint8> m_pickupTypes;
+    QVector<quint8> m_dropOffTypes;
+    QVector<QSharedPointer<QRail::Fragments::Fragment> > m_fragments;
+};
+}
+}
+
+#endif // FRAGMENTSCONNECTIONTABLE_H
@@ -28,6 +28,7 @@
 #include <QtCore/QMutex>
 #include <QtCore/QMutexLocker>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QHash>
 
 #include "fragments/fragmentsfragment.h"
 #include "fragments/fragmentspage.h"
@@ -44,6 +45,8 @@
 #define GTFS_MUST_PHONE "gtfs:MustPhone"
 #define GTFS_MUST_COORDINATE_WITH_DRIVER "gtfs:MustCoordinateWithDriver"
 
+#define PREFETCH_MAX_PAGES 32 // Maximum number of prefetched pages waiting for a caller
+
 #define VERBOSE_HTTP_STATUS // Show HTTP results
 
 // Factory pattern to generate Linked Connections fragments on the fly
@@ -65,20 +68,48 @@ public:
         Constructs a QRail::Fragments::Factory if none exists and returns the
         instance.
      */
+    //! The direction in which pages are prefetched.
+    enum class Direction {
+        PREVIOUS,
+        NEXT
+    };
+    Q_ENUM(Direction)
     static QRail::Fragments::Factory *getInstance(QRail::Network::EventSource::Subscription subscriptionType);
     //! Fetches a Linked Connections page.
     /*!
         \param uri The URI of the page you want to fetch.
         \param caller The caller of this method.
+        \param requestID An identifier chosen by the caller, passed back with the page.
+        \note The page is emitted through the pageDispatched signal together with the caller and the request ID.
+               Callers running in another thread should invoke this method through QMetaObject::invokeMethod.
      */
-    void getPage(const QUrl &uri);
+    Q_INVOKABLE void getPage(const QUrl &uri, QObject *caller = nullptr, const quint64 requestID = 0);
     //! Fetches a Linked Connections page.
     /*!
         \param departureTime The timestamp of the page (departure time).
                The page will contain at least this timestamp and the next connections that are following on this timestamp.
         \param caller The caller of this method.
+        \param requestID An identifier chosen by the caller, passed back with the page.
+        \note The page is emitted through the pageDispatched signal together with the caller and the request ID.
+               Callers running in another thread should invoke this method through QMetaObject::invokeMethod.
+     */
+    Q_INVOKABLE void getPage(const QDateTime &departureTime, QObject *caller = nullptr, const quint64 requestID = 0);
+    //! Prefetches Linked Connections pages.
+    /*!
+        \param uri The URI of the first page you want to prefetch.
+        \param depth The number of pages to prefetch, following the hydra links.
+        \param direction Follow the hydra:previous or hydra:next links.
+        \note Prefetched pages aren't dispatched, they're kept aside until a caller requests them through getPage.
+               A getPage call for a page which is still in flight waits for that request instead of starting a new one.
+               With real time updates enabled, getPage serves the cached page first since updates are only applied to the cache.
+     */
+    Q_INVOKABLE void prefetchPages(const QUrl &uri, const quint16 depth, QRail::Fragments::Factory::Direction direction = QRail::Fragments::Factory::Direction::PREVIOUS);
+    //! Gets the update version of the pages.
+    /*!
+        \return A counter which is incremented for every real time update applied to the cached pages.
+        \note Results derived from the pages are outdated when the version changed.
      */
-    void getPage(const QDateTime &departureTime);
+    quint64 updateVersion() const;
     //! Mutex access to page cache
     QRail::Fragments::Cache* pageCache() const;
     void setPageCache(QRail::Fragments::Cache* pageCache);
@@ -86,6 +117,8 @@ public:
 signals:
     //! Emitted when a page has been become ready.
     void pageReady(QSharedPointer<QRail::Fragments::Page> page);
+    //! Emitted when a page has become ready for the caller which requested it.
+    void pageDispatched(QSharedPointer<QRail::Fragments::Page> page, QObject *caller, quint64 requestID);
     //! Emitted when a resource is fetched from the Network::Manager.
     void getResource(const QUrl &uri);
     //! Emitted when an error occurred during processing.
@@ -110,11 +143,30 @@ private:
     mutable QMutex m_cache_mutex;
     QRail::Network::EventSource *m_eventSource;
     QRail::Fragments::Cache* m_pageCache;
+    quint64 m_updateVersion;
     QRail::Fragments::Fragment::GTFSTypes parseGTFSType(QString type);
     static QRail::Fragments::Factory *m_instance;
     QRail::Network::Manager *m_http;
-    QSharedPointer<QNetworkReply> m_reply;
-    void getPageByURIFromNetworkManager(const QUrl &uri);
+    struct Caller {
+        QObject *caller;
+        quint64 requestID;
+    };
+    struct Request {
+        QUrl uri;
+        QList<QRail::Fragments::Factory::Caller> callers;
+        quint16 prefetchDepth;
+        QRail::Fragments::Factory::Direction direction;
+    };
+    QHash<QNetworkReply *, QRail::Fragments::Factory::Request> m_requests;
+    QHash<QUrl, QNetworkReply *> m_inFlight;
+    QHash<QUrl, QSharedPointer<QRail::Fragments::Page> > m_prefetchedPages;
+    QList<QUrl> m_prefetchedOrder;
+    void addPrefetchedPage(const QUrl &uri, QSharedPointer<QRail::Fragments::Page> page);
+    void getPageByURIFromNetworkManager(const QUrl &uri,
+                                        QObject *caller,
+                                        const quint64 requestID,
+                                        const quint16 prefetchDepth,
+                                        QRail::Fragments::Factory::Direction direction);
     QSharedPointer<QRail::Fragments::Fragment> generateFragmentFromJSON(const QJsonObject &data);
     explicit Factory(QRail::Network::EventSource::Subscription subscriptionType, QObject *parent = nullptr);
     QRail::Network::EventSource::Subscription m_subscriptionType;
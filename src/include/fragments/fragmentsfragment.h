@@ -23,6 +23,7 @@
 #include <QtCore/QUrl>
 #include <QtCore/QDateTime>
 #include <QtCore/QString>
+#include "fragments/fragmentsuriindex.h"
 
 namespace QRail {
 namespace Fragments {
@@ -85,8 +86,10 @@ public:
     void setURI(const QUrl &uri);
     QUrl departureStationURI() const;
     void setDepartureStationURI(const QUrl &departureStationURI);
+    quint32 departureStationID() const;
     QUrl arrivalStationURI() const;
     void setArrivalStationURI(const QUrl &arrivalStationURI);
+    quint32 arrivalStationID() const;
     QDateTime departureTime() const;
     void setDepartureTime(const QDateTime &departureTime);
     QDateTime arrivalTime() const;
@@ -97,8 +100,10 @@ public:
     void setArrivalDelay(const qint16 &arrivalDelay);
     QUrl tripURI() const;
     void setTripURI(const QUrl &tripURI);
+    quint32 tripID() const;
     QUrl routeURI() const;
     void setRouteURI(const QUrl &routeURI);
+    quint32 routeID() const;
     QString direction() const;
     void setDirection(const QString &direction);
     GTFSTypes pickupType() const;
@@ -124,12 +129,16 @@ private:
     QUrl m_uri;
     QUrl m_departureStationURI;
     QUrl m_arrivalStationURI;
+    quint32 m_departureStationID;
+    quint32 m_arrivalStationID;
     QDateTime m_departureTime;
     QDateTime m_arrivalTime;
     qint16 m_departureDelay;
     qint16 m_arrivalDelay;
     QUrl m_tripURI;
     QUrl m_routeURI;
+    quint32 m_tripID;
+    quint32 m_routeID;
     QString m_direction;
     GTFSTypes m_pickupType;
     GTFSTypes m_dropOffType;
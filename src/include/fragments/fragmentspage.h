@@ -23,6 +23,7 @@
 #include <QtCore/QList>
 #include <QtCore/QSharedPointer>
 #include "fragments/fragmentsfragment.h"
+#include "fragments/fragmentsconnectiontable.h"
 
 namespace QRail {
 namespace Fragments {
@@ -48,6 +49,7 @@ public:
         \param hydraPrevious The hydra previous, follow this URI to get the previous page.
         \param fragments The list of fragments associated with this page.
         \param parent QObject parent-child memory management.
+        \note The fragments are owned by their shared pointers only, they can be shared by several pages.
      */
     explicit Page(
         const QUrl &uri,
@@ -67,6 +69,14 @@ public:
     void setHydraPrevious(const QUrl &hydraPrevious);
     QList<QSharedPointer<QRail::Fragments::Fragment>> fragments() const;
     void setFragments(const QList<QSharedPointer<QRail::Fragments::Fragment>> &fragments);
+    //! Gets the connections of the page in a columnar layout.
+    /*!
+        \return A Fragments::ConnectionTable with a row for each fragment of the page.
+        \public
+        The table is rebuilt every time the fragments of the page are changed.
+        Callers can keep the returned table while the page is updated.
+     */
+    QSharedPointer<QRail::Fragments::ConnectionTable> connectionTable() const;
 
 signals:
     void uriChanged();
@@ -81,6 +91,7 @@ private:
     QUrl m_hydraNext;
     QUrl m_hydraPrevious;
     QList<QSharedPointer<QRail::Fragments::Fragment>> m_fragments;
+    QSharedPointer<QRail::Fragments::ConnectionTable> m_connectionTable;
 };
 }
 }
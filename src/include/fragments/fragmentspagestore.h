@@ -0,0 +1,120 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSPAGESTORE_H
+#define FRAGMENTSPAGESTORE_H
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtCore/QUrl>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QDebug>
+#include <limits>
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentsfragment.h"
+
+#define PAGE_STORE_MAGIC 0x51525047 // "QRPG", marks the start of every record
+#define PAGE_STORE_VERSION 1
+#define PAGE_STORE_HEADER_SIZE 8 // Magic and record length
+
+namespace QRail {
+namespace Fragments {
+//! A Fragments::PageStore keeps Linked Connections pages in an append-only binary segment file.
+/*!
+    \class PageStore
+    Every record starts with a small header: the URI of the page, its next page and the departure time
+    of its first connection. The index is rebuilt from these headers when the store is opened, the
+    pages themselves are only decoded when they are read. The URIs of a page are interned in a string
+    table and all times are stored as milliseconds since the epoch. The segment file is memory mapped,
+    a newer record of a page supersedes the older ones and the dead records are compacted away when
+    they take up more than half of the file. A PageStore can be used from multiple threads.
+ */
+class PageStore
+{
+public:
+    //! The header of a record in the segment file.
+    struct Entry {
+        QUrl uri;
+        QUrl hydraNext;
+        QDateTime firstDepartureTime;
+        qint64 offset;
+        quint32 length;
+    };
+    //! Constructs a Fragments::PageStore.
+    /*!
+        \param path The path of the segment file, the file is created if it doesn't exist.
+        \public
+        Opens the segment file and reads the record headers to build the index.
+     */
+    explicit PageStore(const QString &path);
+    ~PageStore();
+    //! Appends a page to the segment file.
+    /*!
+        \param page The page to store, replaces any older record of the page.
+        \return true if the page has been written.
+        \public
+     */
+    bool write(QSharedPointer<QRail::Fragments::Page> page);
+    //! Reads a page from the segment file.
+    /*!
+        \param uri The URI of the page.
+        \return The decoded page or a null pointer if the page isn't stored or can't be decoded.
+        \public
+     */
+    QSharedPointer<QRail::Fragments::Page> read(const QUrl &uri);
+    //! Checks if a page is stored.
+    /*!
+        \param uri The URI of the page.
+        \return true if the page is stored.
+        \public
+     */
+    bool contains(const QUrl &uri) const;
+    //! Gets the headers of all stored pages.
+    /*!
+        \return The headers of the most recent record of every page.
+        \public
+     */
+    QList<QRail::Fragments::PageStore::Entry> entries() const;
+
+private:
+    mutable QMutex m_mutex;
+    QFile m_file;
+    uchar *m_map;
+    qint64 m_mapSize;
+    qint64 m_deadBytes;
+    QHash<QUrl, QRail::Fragments::PageStore::Entry> m_index;
+    void scan();
+    void compact();
+    const uchar *map(const qint64 offset, const quint32 length);
+    void unmap();
+    QByteArray encode(QSharedPointer<QRail::Fragments::Page> page) const;
+    QSharedPointer<QRail::Fragments::Page> decode(const QByteArray &record) const;
+    static bool readHeader(QDataStream &stream, QRail::Fragments::PageStore::Entry &entry);
+    static qint64 toMSecs(const QDateTime &time);
+    static QDateTime fromMSecs(const qint64 msecs);
+};
+}
+}
+
+#endif // FRAGMENTSPAGESTORE_H
@@ -0,0 +1,99 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSPAGEWRITER_H
+#define FRAGMENTSPAGEWRITER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QUrl>
+#include <QtCore/QTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QDebug>
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentspagestore.h"
+
+#define PAGE_WRITER_FLUSH_INTERVAL 2000 // Time in ms dirty pages are kept before they're written
+
+namespace QRail {
+namespace Fragments {
+//! A Fragments::PageWriter writes dirty pages to a Fragments::PageStore in the background.
+/*!
+    \class PageWriter
+    The writer is moved to its own thread by the Fragments::Cache. Pages are queued as dirty and written
+    after PAGE_WRITER_FLUSH_INTERVAL ms, a page which is queued again before that is only written once.
+    A snapshot of the page is queued. The snapshot shares the fragments of the page, which are never modified
+    after parsing: an update replaces the page in the cache by a copy with new fragments. The shared pointers
+    of the snapshot keep the fragments alive until they're written, even when the cache evicts the page meanwhile.
+ */
+class PageWriter : public QObject
+{
+    Q_OBJECT
+public:
+    //! Constructs a Fragments::PageWriter.
+    /*!
+        \param store The page store to write to.
+        \param parent QObject parent-child memory management.
+        \public
+     */
+    explicit PageWriter(QRail::Fragments::PageStore *store, QObject *parent = nullptr);
+    //! Queues a page to be written.
+    /*!
+        \param page The page to write, replaces a queued version of the same page.
+        \public
+        Can be called from any thread, never blocks on the filesystem.
+     */
+    void enqueue(QSharedPointer<QRail::Fragments::Page> page);
+    //! Gets a queued page which hasn't been written yet.
+    /*!
+        \param uri The URI of the page.
+        \return The queued page or a null pointer if the page isn't queued.
+        \public
+     */
+    QSharedPointer<QRail::Fragments::Page> pendingPage(const QUrl &uri) const;
+    //! Gets the number of queued pages.
+    /*!
+        \return The number of pages which haven't been written yet.
+        \public
+     */
+    qint32 pendingCount() const;
+
+public slots:
+    //! Writes all queued pages.
+    /*!
+        \public
+        Blocks until the pages are written, called from the writer thread when the flush interval expires.
+     */
+    void flush();
+
+private slots:
+    void scheduleFlush();
+
+private:
+    QRail::Fragments::PageStore *m_store;
+    mutable QMutex m_queueMutex;
+    QMutex m_flushMutex;
+    QHash<QUrl, QSharedPointer<QRail::Fragments::Page>> m_dirty;
+    QList<QUrl> m_dirtyOrder;
+    QHash<QUrl, QSharedPointer<QRail::Fragments::Page>> m_writing;
+};
+}
+}
+
+#endif // FRAGMENTSPAGEWRITER_H
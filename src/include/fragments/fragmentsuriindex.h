@@ -0,0 +1,93 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSURIINDEX_H
+#define FRAGMENTSURIINDEX_H
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtCore/QUrl>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QReadLocker>
+#include <QtCore/QWriteLocker>
+
+#define INVALID_URI_ID 0xFFFFFFFF // Returned for URIs which aren't interned
+
+namespace QRail {
+namespace Fragments {
+//! A Fragments::URIIndex maps URIs to dense 32-bit identifiers.
+/*!
+    \class URIIndex
+    Stations, trips and routes are interned while the Linked Connections pages are parsed.
+    Each type has its own index so the identifiers stay dense and can be used to index flat arrays.
+ */
+class URIIndex
+{
+public:
+    //! The kind of URIs kept in an index.
+    enum class Type {
+        STATION = 0,
+        TRIP = 1,
+        ROUTE = 2
+    };
+    //! Gets the Fragments::URIIndex instance for the given type.
+    /*!
+        \param type The type of URIs you want to intern.
+        \return An instance of Fragments::URIIndex.
+        \public
+        Constructs a Fragments::URIIndex for the type if none exists and returns the instance.
+     */
+    static URIIndex *getInstance(QRail::Fragments::URIIndex::Type type);
+    //! Interns a URI.
+    /*!
+        \param uri The URI to intern.
+        \return The identifier of the URI, a new identifier is assigned if the URI is unknown.
+        \public
+     */
+    quint32 intern(const QUrl &uri);
+    //! Looks up the identifier of a URI.
+    /*!
+        \param uri The URI to look up.
+        \return The identifier of the URI or INVALID_URI_ID if the URI isn't interned.
+        \public
+     */
+    quint32 id(const QUrl &uri) const;
+    //! Looks up the URI of an identifier.
+    /*!
+        \param id The identifier to look up.
+        \return The URI of the identifier or an empty QUrl if the identifier is unknown.
+        \public
+     */
+    QUrl uri(const quint32 id) const;
+    //! Gets the number of interned URIs.
+    /*!
+        \return The number of interned URIs, all identifiers are lower than this number.
+        \public
+     */
+    quint32 count() const;
+
+private:
+    explicit URIIndex();
+    mutable QReadWriteLock m_lock;
+    QHash<QUrl, quint32> m_ids;
+    QVector<QUrl> m_uris;
+    static URIIndex *m_instances[3];
+};
+}
+}
+
+#endif // FRAGMENTSURIINDEX_H
@@ -54,7 +54,16 @@ SOURCES += src/qrail-tests.cpp \
     src/network/networkmanagertest.cpp \
     src/fragments/fragmentsfragmenttest.cpp \
     src/fragments/fragmentspagetest.cpp \
+    src/fragments/fragmentspagestoretest.cpp \
+    src/fragments/fragmentspagewritertest.cpp \
+    src/fragments/fragmentscachetest.cpp \
+    src/fragments/fragmentstestpages.cpp \
     src/engines/router/routerplannertest.cpp \
+    src/engines/router/routerplannerpooltest.cpp \
+    src/engines/router/routerjourneytest.cpp \
+    src/engines/router/routerquerytest.cpp \
+    src/engines/router/routerjourneycachetest.cpp \
+    src/engines/router/routerdestinationcachetest.cpp \
     src/engines/station/stationfactorytest.cpp \
     src/network/networkeventsourcetest.cpp
 
@@ -63,7 +72,16 @@ HEADERS += \
     src/network/networkmanagertest.h \
     src/fragments/fragmentsfragmenttest.h \
     src/fragments/fragmentspagetest.h \
+    src/fragments/fragmentspagestoretest.h \
+    src/fragments/fragmentspagewritertest.h \
+    src/fragments/fragmentscachetest.h \
+    src/fragments/fragmentstestpages.h \
     src/engines/router/routerplannertest.h \
+    src/engines/router/routerplannerpooltest.h \
+    src/engines/router/routerjourneytest.h \
+    src/engines/router/routerquerytest.h \
+    src/engines/router/routerjourneycachetest.h \
+    src/engines/router/routerdestinationcachetest.h \
     src/engines/station/stationfactorytest.h \
     src/network/networkeventsourcetest.h
 
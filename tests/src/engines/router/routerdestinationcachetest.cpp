@@ -0,0 +1,82 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "routerdestinationcachetest.h"
+using namespace QRail;
+
+void QRail::RouterEngine::DestinationCacheTest::initDestinationCacheTest()
+{
+    qDebug() << "Init QRail::RouterEngine::DestinationCache test";
+    cache = new QRail::RouterEngine::DestinationCache(this);
+}
+
+void QRail::RouterEngine::DestinationCacheTest::runLRUTest()
+{
+    qDebug() << "Running QRail::RouterEngine::DestinationCache LRU test";
+    QUrl brugge = QUrl("http://irail.be/stations/NMBS/008891009");
+    QUrl gent = QUrl("http://irail.be/stations/NMBS/008892007");
+    QUrl vilvoorde = QUrl("http://irail.be/stations/NMBS/008811189");
+    QRail::RouterEngine::DestinationCache::Profile cachedProfile;
+    cache->clear();
+    cache->setMaxSize(2);
+
+    // The least recently stored destination is evicted when the cache is full
+    cache->insert(brugge, this->profile(0));
+    cache->insert(gent, this->profile(0));
+    cache->insert(vilvoorde, this->profile(0));
+    QCOMPARE(cache->size(), 2);
+    QVERIFY(!cache->profile(brugge, 0, &cachedProfile));
+    QVERIFY(cache->profile(gent, 0, &cachedProfile));
+    QVERIFY(cache->profile(vilvoorde, 0, &cachedProfile));
+    QCOMPARE(cachedProfile.maxTransfers, static_cast<qint16>(4));
+
+    // A size of 0 disables the cache
+    cache->setMaxSize(0);
+    QCOMPARE(cache->size(), 0);
+    cache->insert(brugge, this->profile(0));
+    QCOMPARE(cache->size(), 0);
+    cache->setMaxSize(DESTINATION_CACHE_SIZE);
+}
+
+void QRail::RouterEngine::DestinationCacheTest::runUpdateVersionTest()
+{
+    qDebug() << "Running QRail::RouterEngine::DestinationCache update version test";
+    QUrl brugge = QUrl("http://irail.be/stations/NMBS/008891009");
+    QRail::RouterEngine::DestinationCache::Profile cachedProfile;
+    cache->clear();
+
+    // Profiles computed before a real time update are evicted
+    cache->insert(brugge, this->profile(1));
+    QVERIFY(cache->profile(brugge, 1, &cachedProfile));
+    QVERIFY(!cache->profile(brugge, 2, &cachedProfile));
+    QCOMPARE(cache->size(), 0);
+}
+
+void QRail::RouterEngine::DestinationCacheTest::cleanDestinationCacheTest()
+{
+    qDebug() << "Cleaning up QRail::RouterEngine::DestinationCache test";
+    cache->deleteLater();
+}
+
+QRail::RouterEngine::DestinationCache::Profile QRail::RouterEngine::DestinationCacheTest::profile(const quint64 updateVersion) const
+{
+    QRail::RouterEngine::DestinationCache::Profile profile;
+    profile.departureTime = QDateTime::fromString("2018-09-01T10:00:00.000Z", Qt::ISODate).toMSecsSinceEpoch() / 1000;
+    profile.arrivalTime = QDateTime::fromString("2018-09-01T12:00:00.000Z", Qt::ISODate).toMSecsSinceEpoch() / 1000;
+    profile.maxTransfers = 4;
+    profile.updateVersion = updateVersion;
+    return profile;
+}
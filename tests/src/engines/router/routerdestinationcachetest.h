@@ -0,0 +1,44 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERDESTINATIONCACHETEST_H
+#define ROUTERDESTINATIONCACHETEST_H
+
+#include "engines/router/routerdestinationcache.h"
+#include <QtCore/QObject>
+#include <QtCore/QDateTime>
+#include <QtCore/QUrl>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace RouterEngine {
+class DestinationCacheTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initDestinationCacheTest();
+    void runLRUTest();
+    void runUpdateVersionTest();
+    void cleanDestinationCacheTest();
+
+private:
+    QRail::RouterEngine::DestinationCache::Profile profile(const quint64 updateVersion) const;
+    QRail::RouterEngine::DestinationCache *cache;
+};
+}
+}
+
+#endif // ROUTERDESTINATIONCACHETEST_H
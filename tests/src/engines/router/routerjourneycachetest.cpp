@@ -0,0 +1,201 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "routerjourneycachetest.h"
+using namespace QRail;
+
+void QRail::RouterEngine::JourneyCacheTest::initJourneyCacheTest()
+{
+    qDebug() << "Init QRail::RouterEngine::JourneyCache test";
+    cache = new QRail::RouterEngine::JourneyCache(this);
+    departureStation = QUrl("http://irail.be/stations/NMBS/008811189"); // Vilvoorde
+    arrivalStation = QUrl("http://irail.be/stations/NMBS/008891009"); // Brugge
+    departureTime = QDateTime::fromString("2018-09-01T10:00:00.000Z", Qt::ISODate);
+    pageURI = QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-09-01T10:00:00.000Z");
+}
+
+void QRail::RouterEngine::JourneyCacheTest::runLRUTest()
+{
+    qDebug() << "Running QRail::RouterEngine::JourneyCache LRU test";
+    bool isCached = false;
+    cache->clear();
+    cache->setMaxSize(2);
+
+    // Each Journey departs in another time bucket
+    QDateTime firstDeparture = departureTime;
+    QDateTime secondDeparture = departureTime.addSecs(3600);
+    QDateTime thirdDeparture = departureTime.addSecs(2 * 3600);
+    cache->insert(this->journey(firstDeparture, QList<QSharedPointer<QRail::RouterEngine::Route> >()
+                                << this->route(QUrl("http://irail.be/connections/1"), firstDeparture.addSecs(30))));
+    cache->insert(this->journey(secondDeparture, QList<QSharedPointer<QRail::RouterEngine::Route> >()
+                                << this->route(QUrl("http://irail.be/connections/2"), secondDeparture.addSecs(30))));
+    QCOMPARE(cache->size(), 2);
+
+    // A hit makes the first Journey the most recently used one, the second Journey is evicted
+    cache->routes(this->query(firstDeparture), &isCached);
+    QVERIFY(isCached);
+    cache->insert(this->journey(thirdDeparture, QList<QSharedPointer<QRail::RouterEngine::Route> >()
+                                << this->route(QUrl("http://irail.be/connections/3"), thirdDeparture.addSecs(30))));
+    QCOMPARE(cache->size(), 2);
+    cache->routes(this->query(secondDeparture), &isCached);
+    QVERIFY(!isCached);
+    cache->routes(this->query(firstDeparture), &isCached);
+    QVERIFY(isCached);
+    cache->routes(this->query(thirdDeparture), &isCached);
+    QVERIFY(isCached);
+
+    // Shrinking the cache evicts the least recently used Journeys, 0 disables it
+    cache->setMaxSize(1);
+    QCOMPARE(cache->size(), 1);
+    cache->routes(this->query(thirdDeparture), &isCached);
+    QVERIFY(isCached);
+    cache->setMaxSize(0);
+    QCOMPARE(cache->size(), 0);
+    cache->insert(this->journey(firstDeparture, QList<QSharedPointer<QRail::RouterEngine::Route> >()
+                                << this->route(QUrl("http://irail.be/connections/1"), firstDeparture.addSecs(30))));
+    QCOMPARE(cache->size(), 0);
+    cache->setMaxSize(JOURNEY_CACHE_SIZE);
+}
+
+void QRail::RouterEngine::JourneyCacheTest::runWindowTest()
+{
+    qDebug() << "Running QRail::RouterEngine::JourneyCache departure window test";
+    bool isCached = false;
+    cache->clear();
+
+    // Journey planned for 10:00:10, its routes depart in the same bucket
+    QSharedPointer<QRail::RouterEngine::Route> earlyRoute = this->route(QUrl("http://irail.be/connections/1"), departureTime.addSecs(20));
+    QSharedPointer<QRail::RouterEngine::Route> lateRoute = this->route(QUrl("http://irail.be/connections/2"), departureTime.addSecs(50));
+    cache->insert(this->journey(departureTime.addSecs(10), QList<QSharedPointer<QRail::RouterEngine::Route> >() << earlyRoute << lateRoute));
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes = cache->routes(this->query(departureTime.addSecs(10)), &isCached);
+    QVERIFY(isCached);
+    QCOMPARE(routes.size(), 2);
+
+    // A single departure Journey only answers queries for the same departure time, later departures might be missing
+    routes = cache->routes(this->query(departureTime.addSecs(30)), &isCached);
+    QVERIFY(!isCached);
+    QVERIFY(routes.isEmpty());
+    routes = cache->routes(this->query(departureTime.addSecs(5)), &isCached);
+    QVERIFY(!isCached);
+    QVERIFY(routes.isEmpty());
+
+    // Journey scanned from 10:00:10 until 10:10:00
+    QDateTime latestDepartureTime = departureTime.addSecs(600);
+    cache->insert(this->journey(departureTime.addSecs(10), QList<QSharedPointer<QRail::RouterEngine::Route> >() << earlyRoute << lateRoute, latestDepartureTime));
+
+    // Routes departing before the requested departure time aren't returned
+    routes = cache->routes(this->query(departureTime.addSecs(30), latestDepartureTime), &isCached);
+    QVERIFY(isCached);
+    QCOMPARE(routes.size(), 1);
+    QCOMPARE(routes.first(), lateRoute);
+
+    // The requested departure time is exclusive
+    routes = cache->routes(this->query(departureTime.addSecs(20), latestDepartureTime), &isCached);
+    QVERIFY(isCached);
+    QCOMPARE(routes.size(), 1);
+    QCOMPARE(routes.first(), lateRoute);
+
+    // The Journey didn't scan the connections before 10:00:10, it can't answer an earlier query in the same bucket
+    routes = cache->routes(this->query(departureTime.addSecs(5), latestDepartureTime), &isCached);
+    QVERIFY(!isCached);
+    QVERIFY(routes.isEmpty());
+
+    // No cached routes in the requested window is a miss
+    routes = cache->routes(this->query(departureTime.addSecs(50), latestDepartureTime), &isCached);
+    QVERIFY(!isCached);
+    QVERIFY(routes.isEmpty());
+
+    // A narrower Journey doesn't replace a cached Journey which covers it
+    cache->insert(this->journey(departureTime.addSecs(40), QList<QSharedPointer<QRail::RouterEngine::Route> >() << lateRoute, latestDepartureTime));
+    routes = cache->routes(this->query(departureTime.addSecs(15), latestDepartureTime), &isCached);
+    QVERIFY(isCached);
+    QCOMPARE(routes.size(), 2);
+}
+
+void QRail::RouterEngine::JourneyCacheTest::runInvalidationTest()
+{
+    qDebug() << "Running QRail::RouterEngine::JourneyCache invalidation test";
+    bool isCached = false;
+    QUrl connectionURI = QUrl("http://irail.be/connections/1");
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+    routes << this->route(connectionURI, departureTime.addSecs(30));
+    cache->clear();
+
+    // Unrelated pages and connections don't evict the Journey
+    cache->insert(this->journey(departureTime, routes));
+    cache->invalidatePage(QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-09-01T11:00:00.000Z"));
+    QSharedPointer<QRail::Fragments::Fragment> unrelatedFragment(new QRail::Fragments::Fragment());
+    unrelatedFragment->setURI(QUrl("http://irail.be/connections/2"));
+    cache->invalidateFragment(unrelatedFragment);
+    cache->routes(this->query(departureTime), &isCached);
+    QVERIFY(isCached);
+
+    // An update of a scanned page evicts the Journey
+    cache->invalidatePage(pageURI);
+    cache->routes(this->query(departureTime), &isCached);
+    QVERIFY(!isCached);
+    QCOMPARE(cache->size(), 0);
+
+    // An update of a connection of one of its routes evicts the Journey
+    cache->insert(this->journey(departureTime, routes));
+    QSharedPointer<QRail::Fragments::Fragment> fragment(new QRail::Fragments::Fragment());
+    fragment->setURI(connectionURI);
+    cache->invalidateFragment(fragment);
+    cache->routes(this->query(departureTime), &isCached);
+    QVERIFY(!isCached);
+    QCOMPARE(cache->size(), 0);
+}
+
+void QRail::RouterEngine::JourneyCacheTest::cleanJourneyCacheTest()
+{
+    qDebug() << "Cleaning up QRail::RouterEngine::JourneyCache test";
+    cache->deleteLater();
+}
+
+QRail::RouterEngine::Journey *QRail::RouterEngine::JourneyCacheTest::journey(const QDateTime &departureTime, const QList<QSharedPointer<QRail::RouterEngine::Route> > &routes,
+                                                                              const QDateTime &latestDepartureTime)
+{
+    // The cache copies the routes, the Journey isn't needed afterwards
+    QRail::RouterEngine::Journey *journey = new QRail::RouterEngine::Journey(this);
+    journey->setDepartureStationURI(departureStation);
+    journey->setArrivalStationURI(arrivalStation);
+    journey->setDepartureTime(departureTime);
+    journey->setLatestDepartureTime(latestDepartureTime);
+    journey->setMaxTransfers(4);
+    journey->setRoutes(routes);
+    journey->addPageURI(pageURI);
+    return journey;
+}
+
+QSharedPointer<QRail::RouterEngine::Route> QRail::RouterEngine::JourneyCacheTest::route(const QUrl &connectionURI, const QDateTime &departureTime)
+{
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> legDeparture(new QRail::RouterEngine::RouteLegEnd(
+        connectionURI, departureTime, QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+        QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> legArrival(new QRail::RouterEngine::RouteLegEnd(
+        connectionURI, departureTime.addSecs(3600), QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+        QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+    QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > legs;
+    legs.append(QSharedPointer<QRail::RouterEngine::RouteLeg>(new QRail::RouterEngine::RouteLeg(
+        QRail::RouterEngine::RouteLeg::Type::TRAIN, QSharedPointer<QRail::VehicleEngine::Vehicle>(new QRail::VehicleEngine::Vehicle()),
+        legDeparture, legArrival)));
+    return QSharedPointer<QRail::RouterEngine::Route>(new QRail::RouterEngine::Route(legs));
+}
+
+QRail::RouterEngine::Query QRail::RouterEngine::JourneyCacheTest::query(const QDateTime &departureTime, const QDateTime &latestDepartureTime) const
+{
+    return QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, 4, latestDepartureTime);
+}
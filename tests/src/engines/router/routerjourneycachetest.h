@@ -0,0 +1,61 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERJOURNEYCACHETEST_H
+#define ROUTERJOURNEYCACHETEST_H
+
+#include "engines/router/routerjourneycache.h"
+#include "engines/router/routerjourney.h"
+#include "engines/router/routerquery.h"
+#include "engines/router/routerroute.h"
+#include "engines/router/routerrouteleg.h"
+#include "engines/router/routerroutelegend.h"
+#include "engines/station/stationstation.h"
+#include "engines/vehicle/vehiclevehicle.h"
+#include "fragments/fragmentsfragment.h"
+#include <QtCore/QObject>
+#include <QtCore/QDateTime>
+#include <QtCore/QUrl>
+#include <QtCore/QSharedPointer>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace RouterEngine {
+class JourneyCacheTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initJourneyCacheTest();
+    void runLRUTest();
+    void runWindowTest();
+    void runInvalidationTest();
+    void cleanJourneyCacheTest();
+
+private:
+    QRail::RouterEngine::Journey *journey(const QDateTime &departureTime, const QList<QSharedPointer<QRail::RouterEngine::Route> > &routes,
+                                          const QDateTime &latestDepartureTime = QDateTime());
+    QSharedPointer<QRail::RouterEngine::Route> route(const QUrl &connectionURI, const QDateTime &departureTime);
+    QRail::RouterEngine::Query query(const QDateTime &departureTime, const QDateTime &latestDepartureTime = QDateTime()) const;
+    QRail::RouterEngine::JourneyCache *cache;
+    QUrl departureStation;
+    QUrl arrivalStation;
+    QDateTime departureTime;
+    QUrl pageURI;
+};
+} // namespace RouterEngine
+} // namespace QRail
+
+#endif // ROUTERJOURNEYCACHETEST_H
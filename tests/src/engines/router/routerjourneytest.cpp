@@ -0,0 +1,152 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "routerjourneytest.h"
+using namespace QRail;
+
+void QRail::RouterEngine::JourneyTest::initJourneyTest()
+{
+    qDebug() << "Init QRail::RouterEngine::Journey test";
+    journey = new QRail::RouterEngine::Journey(this);
+    journey->setMaxTransfers(2);
+    journey->resizeArrays(1, 1);
+}
+
+void QRail::RouterEngine::JourneyTest::runTransferIndexTest()
+{
+    qDebug() << "Running QRail::RouterEngine::Journey transfer index test";
+
+    // DESCENDING departure and arrival times, the last two profiles have too much transfers
+    journey->appendSArrayAt(0, this->profile(1000, 2000, 0));
+    journey->appendSArrayAt(0, this->profile(900, 1900, 1));
+    journey->appendSArrayAt(0, this->profile(800, 1800, 2));
+    journey->appendSArrayAt(0, this->profile(700, 1700, 3));
+
+    // Earliest reachable departure is the profile at index 3, index 1 is the closest one with less than 2 transfers
+    QCOMPARE(journey->lastReachableSArrayIndex(0, 650), 3);
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 650), 1);
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 950), 0);
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 1100), -1);
+
+    // Replacing the last profile updates the index
+    journey->replaceLastSArrayAt(0, this->profile(700, 1600, 0));
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 650), 3);
+
+    // Changing the maximum number of transfers rebuilds the index
+    journey->setMaxTransfers(1);
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 850), 0);
+    QCOMPARE(journey->lastTransferableSArrayIndex(0, 650), 3);
+
+    // Stations without profiles have nothing to transfer to
+    journey->resizeArrays(2, 1);
+    QCOMPARE(journey->lastTransferableSArrayIndex(1, 650), -1);
+}
+
+void QRail::RouterEngine::JourneyTest::runSnapshotRollbackTest()
+{
+    qDebug() << "Running QRail::RouterEngine::Journey snapshot rollback test";
+    QRail::RouterEngine::Journey *rollbackJourney = new QRail::RouterEngine::Journey(this);
+    rollbackJourney->setMaxTransfers(2);
+    rollbackJourney->resizeArrays(2, 1);
+    QUrl firstPageURI = QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-09-01T12:00:00.000Z");
+    QUrl secondPageURI = QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-09-01T11:00:00.000Z");
+    QUrl thirdPageURI = QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-09-01T10:00:00.000Z");
+    QSharedPointer<QRail::RouterEngine::TrainProfile> firstTrainProfile(new QRail::RouterEngine::TrainProfile(2000, QSharedPointer<QRail::Fragments::Fragment>(), 0));
+    QSharedPointer<QRail::RouterEngine::TrainProfile> secondTrainProfile(new QRail::RouterEngine::TrainProfile(1800, QSharedPointer<QRail::Fragments::Fragment>(), 0));
+    QList<QSharedPointer<QRail::RouterEngine::Route> > firstRoutes;
+    firstRoutes << this->route();
+    QList<QSharedPointer<QRail::RouterEngine::Route> > secondRoutes;
+    secondRoutes << this->route() << this->route();
+
+    // Changes made before the first page aren't recorded, the arrival station seed survives every rollback
+    rollbackJourney->setS_EarliestArrivalTimeAt(1, 5000);
+
+    // Profiles are scanned page by page, each page records its changes in its own snapshot
+    rollbackJourney->addSnapshotJourney(new QRail::RouterEngine::SnapshotJourney(firstPageURI, QUrl(), secondPageURI, rollbackJourney));
+    rollbackJourney->appendSArrayAt(0, this->profile(1000, 2000, 0));
+    rollbackJourney->setTArrayAt(0, firstTrainProfile);
+    rollbackJourney->setT_EarliestArrivalTimeAt(0, 1);
+    rollbackJourney->setS_EarliestArrivalTimeAt(0, 2000);
+    rollbackJourney->setRoutes(firstRoutes);
+
+    rollbackJourney->addSnapshotJourney(new QRail::RouterEngine::SnapshotJourney(secondPageURI, firstPageURI, thirdPageURI, rollbackJourney));
+    rollbackJourney->replaceLastSArrayAt(0, this->profile(1000, 1900, 1));
+    rollbackJourney->appendSArrayAt(0, this->profile(900, 1800, 0));
+    rollbackJourney->setTArrayAt(0, secondTrainProfile);
+    rollbackJourney->setT_EarliestArrivalTimeAt(0, 0);
+    rollbackJourney->setS_EarliestArrivalTimeAt(0, 1800);
+    rollbackJourney->setRoutes(secondRoutes);
+
+    rollbackJourney->addSnapshotJourney(new QRail::RouterEngine::SnapshotJourney(thirdPageURI, secondPageURI, QUrl(), rollbackJourney));
+    rollbackJourney->appendSArrayAt(1, this->profile(800, 1700, 0));
+    QCOMPARE(rollbackJourney->snapshotCount(), 3);
+
+    // Restoring before the second page undoes the second and third page, newest first
+    QCOMPARE(rollbackJourney->restoreBeforePage(secondPageURI), QDateTime::fromString("2018-09-01T11:00:00.000Z", Qt::ISODate));
+    QCOMPARE(rollbackJourney->snapshotCount(), 1);
+    QCOMPARE(rollbackJourney->SArrayAt(0).size(), 1);
+    QCOMPARE(rollbackJourney->SArrayAt(0).first()->arrivalTime(), 2000);
+    QCOMPARE(rollbackJourney->SArrayAt(0).first()->transfers(), 0);
+    QCOMPARE(rollbackJourney->SArrayAt(1).size(), 0);
+    QCOMPARE(rollbackJourney->TArrayAt(0), firstTrainProfile);
+    QCOMPARE(rollbackJourney->T_EarliestArrivalTimeAt(0), 1);
+    QCOMPARE(rollbackJourney->S_EarliestArrivalTimeAt(0), 2000);
+    QCOMPARE(rollbackJourney->S_EarliestArrivalTimeAt(1), 5000);
+    QCOMPARE(rollbackJourney->routes(), firstRoutes);
+    QCOMPARE(rollbackJourney->hydraNext(), QUrl());
+    QCOMPARE(rollbackJourney->hydraPrevious(), secondPageURI);
+
+    // The transfer index follows the restored profiles
+    QCOMPARE(rollbackJourney->lastTransferableSArrayIndex(0, 950), 0);
+
+    // Restoring before the first page undoes every page
+    rollbackJourney->restoreBeforePage(firstPageURI);
+    QCOMPARE(rollbackJourney->snapshotCount(), 0);
+    QCOMPARE(rollbackJourney->SArrayAt(0).size(), 0);
+    QVERIFY(rollbackJourney->TArrayAt(0).isNull());
+    QCOMPARE(rollbackJourney->T_EarliestArrivalTimeAt(0), 0);
+    QCOMPARE(rollbackJourney->S_EarliestArrivalTimeAt(0), 0);
+    QCOMPARE(rollbackJourney->S_EarliestArrivalTimeAt(1), 5000);
+    QVERIFY(rollbackJourney->routes().isEmpty());
+    QCOMPARE(rollbackJourney->lastTransferableSArrayIndex(0, 950), -1);
+    rollbackJourney->deleteLater();
+}
+
+void QRail::RouterEngine::JourneyTest::cleanJourneyTest()
+{
+    qDebug() << "Cleaning up QRail::RouterEngine::Journey test";
+    journey->deleteLater();
+}
+
+QSharedPointer<QRail::RouterEngine::StationStopProfile> QRail::RouterEngine::JourneyTest::profile(const qint64 departureTime,
+                                                                                                 const qint64 arrivalTime,
+                                                                                                 const qint16 transfers)
+{
+    return QSharedPointer<QRail::RouterEngine::StationStopProfile>::create(departureTime, arrivalTime,
+                                                                             QSharedPointer<QRail::Fragments::Fragment>(),
+                                                                             QSharedPointer<QRail::Fragments::Fragment>(),
+                                                                             transfers);
+}
+
+QSharedPointer<QRail::RouterEngine::Route> QRail::RouterEngine::JourneyTest::route()
+{
+    // Only the identity of the routes matters for the rollback
+    return QSharedPointer<QRail::RouterEngine::Route>(new QRail::RouterEngine::Route(QList<QSharedPointer<QRail::RouterEngine::RouteLeg> >(),
+                                                                                        QList<QSharedPointer<QRail::RouterEngine::Transfer> >(),
+                                                                                        QList<QSharedPointer<QRail::AlertsEngine::Message> >(),
+                                                                                        QList<QSharedPointer<QRail::AlertsEngine::Message> >(),
+                                                                                        QList<QSharedPointer<QRail::AlertsEngine::Message> >()));
+}
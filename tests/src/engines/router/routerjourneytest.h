@@ -0,0 +1,49 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERJOURNEYTEST_H
+#define ROUTERJOURNEYTEST_H
+
+#include "engines/router/routerjourney.h"
+#include "engines/router/routerstationstopprofile.h"
+#include "engines/router/routertrainprofile.h"
+#include "engines/router/routersnapshotjourney.h"
+#include "engines/router/routerroute.h"
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace RouterEngine {
+class JourneyTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initJourneyTest();
+    void runTransferIndexTest();
+    void runSnapshotRollbackTest();
+    void cleanJourneyTest();
+
+private:
+    QSharedPointer<QRail::RouterEngine::StationStopProfile> profile(const qint64 departureTime, const qint64 arrivalTime, const qint16 transfers);
+    QSharedPointer<QRail::RouterEngine::Route> route();
+    QRail::RouterEngine::Journey *journey;
+};
+} // namespace RouterEngine
+} // namespace QRail
+
+#endif // ROUTERJOURNEYTEST_H
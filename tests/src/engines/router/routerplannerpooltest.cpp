@@ -0,0 +1,108 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "routerplannerpooltest.h"
+using namespace QRail;
+
+void QRail::RouterEngine::PlannerPoolTest::initPlannerPoolTest()
+{
+    qDebug() << "Init QRail::RouterEngine::PlannerPool test";
+    pool = QRail::RouterEngine::PlannerPool::getInstance();
+    departureStation = QUrl("http://irail.be/stations/NMBS/008811189"); // Vilvoorde
+    arrivalStation = QUrl("http://irail.be/stations/NMBS/008891009"); // Brugge
+    departureTime = QDateTime::fromString("2019-11-28T14:00:00.000Z", Qt::ISODate);
+}
+
+void QRail::RouterEngine::PlannerPoolTest::runQueueTest()
+{
+    qDebug() << "Running QRail::RouterEngine::PlannerPool queue test";
+    QSignalSpy finishedSpy(pool, SIGNAL(finished(QRail::RouterEngine::Journey*)));
+    QSignalSpy errorSpy(pool, SIGNAL(error(QString)));
+    QVERIFY(pool->size() > 0);
+    QCOMPARE(pool->pendingQueries(), 0);
+
+    // Invalid queries are rejected without occupying a planner
+    pool->getConnections(QUrl(), arrivalStation, departureTime, 4);
+    pool->getConnections(departureStation, arrivalStation, departureTime, departureTime.addSecs(-3600), 4);
+    QCOMPARE(errorSpy.count(), 2);
+    QCOMPARE(pool->pendingQueries(), 0);
+
+    // Every idle planner takes a query right away
+    for (qint32 i = 0; i < pool->size(); i++) {
+        pool->getConnections(departureStation, arrivalStation, departureTime.addSecs(60 * i), 4);
+    }
+    QCOMPARE(pool->pendingQueries(), 0);
+
+    // Queries are queued once every planner is busy, each slice of a range query is a query
+    pool->getConnections(departureStation, arrivalStation, departureTime, 4);
+    QCOMPARE(pool->pendingQueries(), 1);
+    pool->getConnections(departureStation, arrivalStation, departureTime, departureTime.addSecs(3600), 4, 3);
+    QCOMPARE(pool->pendingQueries(), 4);
+
+    // Queued queries run when a planner becomes idle, the slices are reported as one Journey
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), pool->size() + 2, POOL_TIMEOUT);
+    QCOMPARE(pool->pendingQueries(), 0);
+}
+
+void QRail::RouterEngine::PlannerPoolTest::runParetoTest()
+{
+    qDebug() << "Running QRail::RouterEngine::PlannerPool Pareto test";
+    QSharedPointer<QRail::RouterEngine::Route> earlier = this->route("2019-11-28T14:00:00.000Z", "2019-11-28T15:00:00.000Z", 1);
+    QSharedPointer<QRail::RouterEngine::Route> later = this->route("2019-11-28T14:10:00.000Z", "2019-11-28T15:00:00.000Z", 1);
+    QSharedPointer<QRail::RouterEngine::Route> direct = this->route("2019-11-28T14:20:00.000Z", "2019-11-28T15:30:00.000Z", 1);
+    QSharedPointer<QRail::RouterEngine::Route> faster = this->route("2019-11-28T14:20:00.000Z", "2019-11-28T15:20:00.000Z", 2);
+    QSharedPointer<QRail::RouterEngine::Route> transfer = this->route("2019-11-28T14:20:00.000Z", "2019-11-28T15:30:00.000Z", 2);
+
+    // Routes of different slices, in no particular order
+    QList<QSharedPointer<QRail::RouterEngine::Route> > routes;
+    routes << transfer << direct << earlier << faster << later;
+    QList<QSharedPointer<QRail::RouterEngine::Route> > paretoRoutes = QRail::RouterEngine::PlannerPool::paretoRoutes(routes);
+
+    // Departing later with the same arrival time or arriving at the same time with more transfers is dominated
+    QCOMPARE(paretoRoutes.size(), 3);
+    QVERIFY(!paretoRoutes.contains(earlier));
+    QVERIFY(!paretoRoutes.contains(transfer));
+
+    // Trading an earlier arrival for more transfers isn't dominated, the routes are sorted by departure time
+    QCOMPARE(paretoRoutes.first(), later);
+    QVERIFY(paretoRoutes.contains(direct));
+    QVERIFY(paretoRoutes.contains(faster));
+}
+
+void QRail::RouterEngine::PlannerPoolTest::cleanPlannerPoolTest()
+{
+    qDebug() << "Cleaning up QRail::RouterEngine::PlannerPool test";
+}
+
+QSharedPointer<QRail::RouterEngine::Route> QRail::RouterEngine::PlannerPoolTest::route(const QString &departureTime, const QString &arrivalTime, const qint32 legCount)
+{
+    // Legs of equal duration, one after the other
+    QDateTime departure = QDateTime::fromString(departureTime, Qt::ISODate);
+    qint64 legDuration = departure.secsTo(QDateTime::fromString(arrivalTime, Qt::ISODate)) / legCount;
+    QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > legs;
+    for (qint32 i = 0; i < legCount; i++) {
+        QSharedPointer<QRail::RouterEngine::RouteLegEnd> legDeparture(new QRail::RouterEngine::RouteLegEnd(
+            QUrl(), departure.addSecs(legDuration * i), QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+            QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+        QSharedPointer<QRail::RouterEngine::RouteLegEnd> legArrival(new QRail::RouterEngine::RouteLegEnd(
+            QUrl(), departure.addSecs(legDuration * (i + 1)), QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+            QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+        legs.append(QSharedPointer<QRail::RouterEngine::RouteLeg>(new QRail::RouterEngine::RouteLeg(
+            QRail::RouterEngine::RouteLeg::Type::TRAIN, QSharedPointer<QRail::VehicleEngine::Vehicle>(new QRail::VehicleEngine::Vehicle()),
+            legDeparture, legArrival)));
+    }
+    return QSharedPointer<QRail::RouterEngine::Route>(new QRail::RouterEngine::Route(legs));
+}
@@ -0,0 +1,55 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERPLANNERPOOLTEST_H
+#define ROUTERPLANNERPOOLTEST_H
+
+#include "engines/router/routerplannerpool.h"
+#include "engines/router/routerroute.h"
+#include "engines/router/routerrouteleg.h"
+#include "engines/router/routerroutelegend.h"
+#include "engines/station/stationstation.h"
+#include "engines/vehicle/vehiclevehicle.h"
+#include <QtCore/QObject>
+#include <QtCore/QDateTime>
+#include <QtCore/QUrl>
+#include <QtCore/QSharedPointer>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QtTest>
+#define POOL_TIMEOUT 600000 // Every query of the test has to finish within 10 minutes
+
+namespace QRail {
+namespace RouterEngine {
+class PlannerPoolTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initPlannerPoolTest();
+    void runQueueTest();
+    void runParetoTest();
+    void cleanPlannerPoolTest();
+
+private:
+    QSharedPointer<QRail::RouterEngine::Route> route(const QString &departureTime, const QString &arrivalTime, const qint32 legCount);
+    QRail::RouterEngine::PlannerPool *pool;
+    QUrl departureStation;
+    QUrl arrivalStation;
+    QDateTime departureTime;
+};
+} // namespace RouterEngine
+} // namespace QRail
+
+#endif // ROUTERPLANNERPOOLTEST_H
@@ -154,6 +154,56 @@ void QRail::RouterEngine::PlannerTest::runCSAPlannerTest()
     }*/
 }
 
+void QRail::RouterEngine::PlannerTest::runWatchTest()
+{
+    qDebug() << "Running QRail::RouterEngine::Planner watch test";
+    qRegisterMetaType<QSharedPointer<QRail::Fragments::Fragment> >("QSharedPointer<QRail::Fragments::Fragment>");
+    qRegisterMetaType<QRail::RouterEngine::Journey *>("QRail::RouterEngine::Journey*");
+    QUrl departureConnectionURI = QUrl("http://irail.be/connections/8811189/20180802/IC1832");
+    QUrl arrivalConnectionURI = QUrl("http://irail.be/connections/8891009/20180802/IC1832");
+
+    // Watched Journey with a single leg, not planned by the Planner itself
+    QDateTime departureTime = QDateTime::fromString("2018-08-02T13:00:00.000Z", Qt::ISODate);
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> legDeparture(new QRail::RouterEngine::RouteLegEnd(
+        departureConnectionURI, departureTime, QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+        QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+    QSharedPointer<QRail::RouterEngine::RouteLegEnd> legArrival(new QRail::RouterEngine::RouteLegEnd(
+        arrivalConnectionURI, departureTime.addSecs(3600), QSharedPointer<QRail::StationEngine::Station>(new QRail::StationEngine::Station()),
+        QString("1"), true, 0, false, false, QRail::VehicleEngine::Stop::OccupancyLevel::UNSUPPORTED));
+    QList<QSharedPointer<QRail::RouterEngine::RouteLeg> > legs;
+    legs.append(QSharedPointer<QRail::RouterEngine::RouteLeg>(new QRail::RouterEngine::RouteLeg(
+        QRail::RouterEngine::RouteLeg::Type::TRAIN, QSharedPointer<QRail::VehicleEngine::Vehicle>(new QRail::VehicleEngine::Vehicle()),
+        legDeparture, legArrival)));
+    QRail::RouterEngine::Journey *watchedJourney = new QRail::RouterEngine::Journey(this);
+    watchedJourney->setRoutes(QList<QSharedPointer<QRail::RouterEngine::Route> >()
+                              << QSharedPointer<QRail::RouterEngine::Route>(new QRail::RouterEngine::Route(legs)));
+
+    QSignalSpy updatedSpy(planner, SIGNAL(watchedJourneyUpdated(QRail::RouterEngine::Journey*, QSharedPointer<QRail::Fragments::Fragment>)));
+    planner->watch(watchedJourney);
+
+    // Updates of connections which aren't used by a watched leg aren't reported
+    this->updateFragment(QUrl("http://irail.be/connections/8814001/20180802/IC1832"));
+    QCOMPARE(updatedSpy.count(), 0);
+
+    // Both ends of a watched leg are indexed
+    this->updateFragment(departureConnectionURI);
+    QCOMPARE(updatedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QRail::RouterEngine::Journey *>(updatedSpy.at(0).at(0)), watchedJourney);
+    this->updateFragment(arrivalConnectionURI);
+    QCOMPARE(updatedSpy.count(), 2);
+
+    // Unwatched Journeys are removed from the index
+    planner->unwatch(watchedJourney);
+    this->updateFragment(departureConnectionURI);
+    QCOMPARE(updatedSpy.count(), 2);
+
+    // Destroyed Journeys are removed from the index too
+    planner->watch(watchedJourney);
+    delete watchedJourney;
+    this->updateFragment(departureConnectionURI);
+    QCOMPARE(updatedSpy.count(), 2);
+}
+
 void QRail::RouterEngine::PlannerTest::cleanCSAPlannerTest()
 {
     disconnect(planner,
@@ -174,6 +224,16 @@ void QRail::RouterEngine::PlannerTest::cleanCSAPlannerTest()
                SLOT(processRoutesStream(QSharedPointer<QRail::RouterEngine::Route>)));
 }
 
+void QRail::RouterEngine::PlannerTest::updateFragment(const QUrl &uri)
+{
+    // Simulate a real time update of the Fragments::Factory
+    QSharedPointer<QRail::Fragments::Fragment> fragment(new QRail::Fragments::Fragment());
+    fragment->setURI(uri);
+    QMetaObject::invokeMethod(planner, "handleFragmentAndPageFactoryUpdate", Qt::DirectConnection,
+                              Q_ARG(QSharedPointer<QRail::Fragments::Fragment>, fragment),
+                              Q_ARG(QUrl, QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-08-02T13:00:00.000Z")));
+}
+
 void QRail::RouterEngine::PlannerTest::processing(const QUrl &pageURI)
 {
     qDebug() << "Page received:" << pageURI.toString();
@@ -18,6 +18,13 @@
 #define CSAPLANNERTEST_H
 
 #include "engines/router/routerplanner.h"
+#include "engines/router/routerjourney.h"
+#include "engines/router/routerroute.h"
+#include "engines/router/routerrouteleg.h"
+#include "engines/router/routerroutelegend.h"
+#include "engines/station/stationstation.h"
+#include "engines/vehicle/vehiclevehicle.h"
+#include "fragments/fragmentsfragment.h"
 #include <QtCore/QDateTime>
 #include <QtCore/QObject>
 #include <QtCore/QDateTime>
@@ -34,6 +41,7 @@ class PlannerTest : public QObject
 private slots:
     void initCSAPlannerTest();
     void runCSAPlannerTest();
+    void runWatchTest();
     void cleanCSAPlannerTest();
 
 public slots:
@@ -43,6 +51,7 @@ public slots:
     void requested(const QUrl &pageURI);
 
 private:
+    void updateFragment(const QUrl &uri);
     QRail::RouterEngine::Planner *planner;
     QRail::RouterEngine::Journey *journey;
 };
@@ -0,0 +1,86 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "routerquerytest.h"
+using namespace QRail;
+
+void QRail::RouterEngine::QueryTest::initQueryTest()
+{
+    qDebug() << "Init QRail::RouterEngine::Query test";
+    departureStation = QUrl("http://irail.be/stations/NMBS/008811189"); // Vilvoorde
+    arrivalStation = QUrl("http://irail.be/stations/NMBS/008891009"); // Brugge
+    departureTime = QDateTime::fromString("2018-09-01T10:00:00.000Z", Qt::ISODate);
+}
+
+void QRail::RouterEngine::QueryTest::runValidTest()
+{
+    qDebug() << "Running QRail::RouterEngine::Query validation test";
+
+    // Stations and a departure time are required
+    QVERIFY(!QRail::RouterEngine::Query().isValid());
+    QVERIFY(QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, 4).isValid());
+    QVERIFY(!QRail::RouterEngine::Query(QUrl(), arrivalStation, departureTime, 4).isValid());
+    QVERIFY(!QRail::RouterEngine::Query(departureStation, QUrl(), departureTime, 4).isValid());
+    QVERIFY(!QRail::RouterEngine::Query(departureStation, arrivalStation, QDateTime(), 4).isValid());
+
+    // A departure time window can't be empty
+    QVERIFY(QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, 4, departureTime.addSecs(3600)).isValid());
+    QVERIFY(!QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, 4, departureTime).isValid());
+    QVERIFY(!QRail::RouterEngine::Query(departureStation, arrivalStation, departureTime, 4, departureTime.addSecs(-3600)).isValid());
+}
+
+void QRail::RouterEngine::QueryTest::runSliceTest()
+{
+    qDebug() << "Running QRail::RouterEngine::Query slice test";
+    QDateTime latestDepartureTime = departureTime.addSecs(3600);
+    QRail::RouterEngine::Query query(departureStation, arrivalStation, departureTime, 4, latestDepartureTime);
+
+    // The requested departure time is exclusive, the latest departure time is inclusive
+    QVERIFY(!query.isInDepartureWindow(departureTime));
+    QVERIFY(query.isInDepartureWindow(departureTime.addSecs(60)));
+    QVERIFY(query.isInDepartureWindow(latestDepartureTime));
+    QVERIFY(!query.isInDepartureWindow(latestDepartureTime.addSecs(60)));
+
+    // Consecutive slices covering the whole window
+    QList<QRail::RouterEngine::Query> slices = query.slices(4);
+    QCOMPARE(slices.size(), 4);
+    QCOMPARE(slices.first().departureTime(), departureTime);
+    QCOMPARE(slices.last().latestDepartureTime(), latestDepartureTime);
+    for (qint32 i = 1; i < slices.size(); i++) {
+        QCOMPARE(slices.at(i).departureTime(), slices.at(i - 1).latestDepartureTime());
+    }
+
+    // A connection departing exactly on a boundary between 2 slices is planned by one slice only
+    QDateTime boundary = departureTime.addSecs(15 * 60);
+    qint32 matchingSlices = 0;
+    foreach (QRail::RouterEngine::Query slice, slices) {
+        if (slice.isInDepartureWindow(boundary)) {
+            QCOMPARE(slice.latestDepartureTime(), boundary);
+            matchingSlices++;
+        }
+    }
+    QCOMPARE(matchingSlices, 1);
+
+    // Queries without a departure time window aren't split
+    QRail::RouterEngine::Query singleQuery(departureStation, arrivalStation, departureTime, 4);
+    QCOMPARE(singleQuery.slices(4).size(), 1);
+    QVERIFY(singleQuery.isInDepartureWindow(departureTime.addSecs(24 * 3600)));
+}
+
+void QRail::RouterEngine::QueryTest::cleanQueryTest()
+{
+    qDebug() << "Cleaning up QRail::RouterEngine::Query test";
+}
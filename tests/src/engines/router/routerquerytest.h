@@ -0,0 +1,45 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTERQUERYTEST_H
+#define ROUTERQUERYTEST_H
+
+#include "engines/router/routerquery.h"
+#include <QtCore/QObject>
+#include <QtCore/QDateTime>
+#include <QtCore/QUrl>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace RouterEngine {
+class QueryTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initQueryTest();
+    void runValidTest();
+    void runSliceTest();
+    void cleanQueryTest();
+
+private:
+    QUrl departureStation;
+    QUrl arrivalStation;
+    QDateTime departureTime;
+};
+} // namespace RouterEngine
+} // namespace QRail
+
+#endif // ROUTERQUERYTEST_H
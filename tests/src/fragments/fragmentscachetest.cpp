@@ -0,0 +1,149 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragmentscachetest.h"
+using namespace QRail;
+
+void QRail::Fragments::CacheTest::initCacheTest()
+{
+    qDebug() << "Init QRail::Fragments::Cache test";
+
+    // Start from an empty disk cache, outside the cache of the user
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fragments").removeRecursively();
+    cache = new QRail::Fragments::Cache(this);
+
+    // Pages of the same size, the cache holds 3 of them
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:00:00.000Z")); // A
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:10:00.000Z")); // B
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:20:00.000Z")); // C
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:30:00.000Z")); // D
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:40:00.000Z")); // E
+    pages.append(QRail::Fragments::TestPages::page("2018-07-21T07:50:00.000Z")); // F
+    cache->cachePage(pages.at(0));
+    pageCost = cache->cost();
+    QVERIFY(pageCost > 0);
+    cache->setMaxCost(3 * pageCost);
+}
+
+void QRail::Fragments::CacheTest::runEvictionTest()
+{
+    qDebug() << "Running QRail::Fragments::Cache CLOCK eviction test";
+    cache->cachePage(pages.at(1));
+    cache->cachePage(pages.at(2));
+    QCOMPARE(cache->cost(), 3 * pageCost);
+    QCOMPARE(cache->evictions(), (quint64) 0);
+
+    // Every page has been used once, the hand clears all reference bits and evicts the oldest page
+    cache->cachePage(pages.at(3));
+    QVERIFY(!cache->hasPage(pages.at(0)->uri()));
+    QVERIFY(cache->hasPage(pages.at(1)->uri()));
+    QCOMPARE(cache->evictions(), (quint64) 1);
+    QCOMPARE(cache->cost(), 3 * pageCost);
+
+    // A page used since the last pass of the hand gets a second chance, the next one is evicted
+    QCOMPARE(cache->getPageByURI(pages.at(1)->uri()), pages.at(1));
+    cache->cachePage(pages.at(4));
+    QVERIFY(cache->hasPage(pages.at(1)->uri()));
+    QVERIFY(!cache->hasPage(pages.at(2)->uri()));
+    QVERIFY(cache->hasPage(pages.at(3)->uri()));
+    QVERIFY(cache->hasPage(pages.at(4)->uri()));
+    QCOMPARE(cache->evictions(), (quint64) 2);
+}
+
+void QRail::Fragments::CacheTest::runPinTest()
+{
+    qDebug() << "Running QRail::Fragments::Cache pin test";
+
+    // Pinned pages are skipped by the hand, the next unpinned page is evicted
+    QList<QUrl> pinned = QList<QUrl>() << pages.at(3)->uri();
+    cache->pinPages(pinned);
+    cache->pinPages(pinned);
+    cache->cachePage(pages.at(5));
+    QVERIFY(cache->hasPage(pages.at(3)->uri()));
+    QVERIFY(!cache->hasPage(pages.at(1)->uri()));
+    QCOMPARE(cache->evictions(), (quint64) 3);
+
+    // Pins are counted, the page stays pinned until every pin is released
+    cache->unpinPages(pinned);
+    cache->setMaxCost(0);
+    QVERIFY(cache->hasPage(pages.at(3)->uri()));
+    QVERIFY(!cache->hasPage(pages.at(4)->uri()));
+    QVERIFY(!cache->hasPage(pages.at(5)->uri()));
+    QCOMPARE(cache->cost(), pageCost);
+    QCOMPARE(cache->evictions(), (quint64) 5);
+
+    cache->unpinPages(pinned);
+    QVERIFY(!cache->hasPage(pages.at(3)->uri()));
+    QVERIFY(cache->isEmpty());
+    QCOMPARE(cache->cost(), (qint64) 0);
+    QCOMPARE(cache->evictions(), (quint64) 6);
+}
+
+void QRail::Fragments::CacheTest::runCountersTest()
+{
+    qDebug() << "Running QRail::Fragments::Cache counters test";
+    cache->setMaxCost(3 * pageCost);
+    quint64 hits = cache->hits();
+    quint64 diskHits = cache->diskHits();
+    quint64 misses = cache->misses();
+
+    // Evicted pages are loaded from the disk tier, queued or written
+    QCOMPARE(cache->getPageByURI(pages.at(0)->uri())->fragments().size(), pages.at(0)->fragments().size());
+    QCOMPARE(cache->diskHits(), diskHits + 1);
+    cache->flush();
+    QCOMPARE(cache->getPageByTime(QDateTime::fromString("2018-07-21T07:15:00.000Z", Qt::ISODate))->uri(), pages.at(1)->uri());
+    QCOMPARE(cache->diskHits(), diskHits + 2);
+
+    // Pages in memory are hits
+    QVERIFY(cache->getPageByURI(pages.at(0)->uri()));
+    QVERIFY(cache->getPageByTime(QDateTime::fromString("2018-07-21T07:05:00.000Z", Qt::ISODate)));
+    QCOMPARE(cache->hits(), hits + 2);
+
+    // Unknown pages and times before the first page are misses
+    QVERIFY(!cache->getPageByURI(QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-07-21T06:00:00.000Z")));
+    QVERIFY(!cache->getPageByTime(QDateTime::fromString("2018-07-21T06:00:00.000Z", Qt::ISODate)));
+    QCOMPARE(cache->misses(), misses + 2);
+    QCOMPARE(cache->hits(), hits + 2);
+    QCOMPARE(cache->diskHits(), diskHits + 2);
+}
+
+void QRail::Fragments::CacheTest::runFragmentLifetimeTest()
+{
+    qDebug() << "Running QRail::Fragments::Cache fragment lifetime test";
+
+    // Only the cache holds the page, profiles and routes only hold its fragments
+    QSharedPointer<QRail::Fragments::Page> evictedPage = QRail::Fragments::TestPages::page("2018-07-21T08:00:00.000Z");
+    QUrl pageURI = evictedPage->uri();
+    QSharedPointer<QRail::Fragments::Fragment> fragment = evictedPage->fragments().first();
+    QUrl fragmentURI = fragment->uri();
+    cache->cachePage(evictedPage);
+    evictedPage.clear();
+
+    // The evicted page is destroyed, its fragments live as long as they're used
+    cache->setMaxCost(0);
+    QVERIFY(!cache->hasPage(pageURI));
+    QCOMPARE(fragment->uri(), fragmentURI);
+    QCOMPARE(fragment->departureTime(), QDateTime::fromString("2018-07-21T08:01:00.000Z", Qt::ISODate));
+}
+
+void QRail::Fragments::CacheTest::cleanCacheTest()
+{
+    qDebug() << "Cleaning up QRail::Fragments::Cache test";
+    delete cache;
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fragments").removeRecursively();
+    QStandardPaths::setTestModeEnabled(false);
+}
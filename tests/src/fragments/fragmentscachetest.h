@@ -0,0 +1,51 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSCACHETEST_H
+#define FRAGMENTSCACHETEST_H
+
+#include "fragments/fragmentscache.h"
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentsfragment.h"
+#include "fragmentstestpages.h"
+#include <QtCore/QObject>
+#include <QtCore/QDir>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QSharedPointer>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace Fragments {
+class CacheTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initCacheTest();
+    void runEvictionTest();
+    void runPinTest();
+    void runCountersTest();
+    void runFragmentLifetimeTest();
+    void cleanCacheTest();
+
+private:
+    QRail::Fragments::Cache *cache;
+    QList<QSharedPointer<QRail::Fragments::Page> > pages;
+    qint64 pageCost;
+};
+} // namespace Fragments
+} // namespace QRail
+
+#endif // FRAGMENTSCACHETEST_H
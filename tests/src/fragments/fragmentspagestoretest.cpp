@@ -0,0 +1,139 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragmentspagestoretest.h"
+using namespace QRail;
+
+void QRail::Fragments::PageStoreTest::initPageStoreTest()
+{
+    qDebug() << "Init QRail::Fragments::PageStore test";
+    dir = new QTemporaryDir();
+    QVERIFY(dir->isValid());
+}
+
+void QRail::Fragments::PageStoreTest::runRoundTripTest()
+{
+    qDebug() << "Running QRail::Fragments::PageStore round trip test";
+    QString path = dir->filePath("roundtrip.segment");
+    QSharedPointer<QRail::Fragments::Page> original = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 2);
+
+    // Write the page and read it back from a freshly opened store
+    {
+        QRail::Fragments::PageStore store(path);
+        QVERIFY(store.write(original));
+        QVERIFY(store.contains(original->uri()));
+    }
+    QRail::Fragments::PageStore store(path);
+    QCOMPARE(store.entries().size(), 1);
+    QCOMPARE(store.entries().first().uri, original->uri());
+    QCOMPARE(store.entries().first().hydraNext, original->hydraNext());
+    QCOMPARE(store.entries().first().firstDepartureTime, original->fragments().first()->departureTime());
+
+    QSharedPointer<QRail::Fragments::Page> decoded = store.read(original->uri());
+    QVERIFY(decoded);
+    QCOMPARE(decoded->uri(), original->uri());
+    QCOMPARE(decoded->timestamp(), original->timestamp());
+    QCOMPARE(decoded->hydraNext(), original->hydraNext());
+    QCOMPARE(decoded->hydraPrevious(), original->hydraPrevious());
+    QCOMPARE(decoded->fragments().size(), original->fragments().size());
+    for (qint32 i = 0; i < original->fragments().size(); i++) {
+        QSharedPointer<QRail::Fragments::Fragment> expected = original->fragments().at(i);
+        QSharedPointer<QRail::Fragments::Fragment> fragment = decoded->fragments().at(i);
+        QCOMPARE(fragment->uri(), expected->uri());
+        QCOMPARE(fragment->departureStationURI(), expected->departureStationURI());
+        QCOMPARE(fragment->arrivalStationURI(), expected->arrivalStationURI());
+        QCOMPARE(fragment->departureTime(), expected->departureTime());
+        QCOMPARE(fragment->arrivalTime(), expected->arrivalTime());
+        QCOMPARE(fragment->departureDelay(), expected->departureDelay());
+        QCOMPARE(fragment->arrivalDelay(), expected->arrivalDelay());
+        QCOMPARE(fragment->tripURI(), expected->tripURI());
+        QCOMPARE(fragment->routeURI(), expected->routeURI());
+        QCOMPARE(fragment->direction(), expected->direction());
+        QCOMPARE(fragment->pickupType(), expected->pickupType());
+        QCOMPARE(fragment->dropOffType(), expected->dropOffType());
+    }
+
+    // Unknown pages aren't stored
+    QVERIFY(!store.read(QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-07-21T06:00:00.000Z")));
+}
+
+void QRail::Fragments::PageStoreTest::runTruncatedTailTest()
+{
+    qDebug() << "Running QRail::Fragments::PageStore truncated tail test";
+    QString path = dir->filePath("truncated.segment");
+    QSharedPointer<QRail::Fragments::Page> first = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 2);
+    QSharedPointer<QRail::Fragments::Page> second = QRail::Fragments::TestPages::page("2018-07-21T07:39:00.000Z", 2);
+    {
+        QRail::Fragments::PageStore store(path);
+        QVERIFY(store.write(first));
+        QVERIFY(store.write(second));
+    }
+    qint64 size = QFileInfo(path).size();
+
+    // Simulate a crash while appending a record: a header announcing more bytes than were written
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::Append));
+    QByteArray partial;
+    QDataStream stream(&partial, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << quint32(PAGE_STORE_MAGIC) << quint32(1024);
+    partial.append("partial");
+    QVERIFY(file.write(partial) == partial.size());
+    file.close();
+
+    // The complete records survive, the partial one is cut off
+    QRail::Fragments::PageStore store(path);
+    QCOMPARE(store.entries().size(), 2);
+    QVERIFY(store.read(first->uri()));
+    QVERIFY(store.read(second->uri()));
+    QCOMPARE(QFileInfo(path).size(), size);
+
+    // New records are appended right after the last complete one
+    QSharedPointer<QRail::Fragments::Page> third = QRail::Fragments::TestPages::page("2018-07-21T07:49:00.000Z", 2);
+    QVERIFY(store.write(third));
+    QVERIFY(store.read(third->uri()));
+}
+
+void QRail::Fragments::PageStoreTest::runCompactionTest()
+{
+    qDebug() << "Running QRail::Fragments::PageStore compaction test";
+    QString path = dir->filePath("compaction.segment");
+    QSharedPointer<QRail::Fragments::Page> original = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 2);
+    QRail::Fragments::PageStore store(path);
+    QVERIFY(store.write(original));
+    qint64 recordSize = QFileInfo(path).size();
+
+    // Rewriting a page leaves a dead record behind until more than half of the file is dead
+    QVERIFY(store.write(original));
+    QCOMPARE(QFileInfo(path).size(), 2 * recordSize);
+    QVERIFY(store.write(original));
+    QCOMPARE(QFileInfo(path).size(), recordSize);
+
+    // The compacted store is readable and complete
+    QCOMPARE(store.entries().size(), 1);
+    QSharedPointer<QRail::Fragments::Page> decoded = store.read(original->uri());
+    QVERIFY(decoded);
+    QCOMPARE(decoded->fragments().size(), original->fragments().size());
+    QVERIFY(store.write(QRail::Fragments::TestPages::page("2018-07-21T07:39:00.000Z", 2)));
+    QCOMPARE(store.entries().size(), 2);
+    QVERIFY(store.read(original->uri()));
+}
+
+void QRail::Fragments::PageStoreTest::cleanPageStoreTest()
+{
+    qDebug() << "Cleaning up QRail::Fragments::PageStore test";
+    delete dir;
+}
@@ -0,0 +1,49 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSPAGESTORETEST_H
+#define FRAGMENTSPAGESTORETEST_H
+
+#include "fragments/fragmentspagestore.h"
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentsfragment.h"
+#include "fragmentstestpages.h"
+#include <QtCore/QObject>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QSharedPointer>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace Fragments {
+class PageStoreTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initPageStoreTest();
+    void runRoundTripTest();
+    void runTruncatedTailTest();
+    void runCompactionTest();
+    void cleanPageStoreTest();
+
+private:
+    QTemporaryDir *dir;
+};
+} // namespace Fragments
+} // namespace QRail
+
+#endif // FRAGMENTSPAGESTORETEST_H
@@ -52,6 +52,36 @@ void QRail::Fragments::PageTest::runLinkedConnectionPageTest()
     page->setHydraPrevious(
         QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-07-24T17:29:00.000Z"));
     QCOMPARE(spyHydraPreviousChanged.count(), 1);
+
+    // The connection table is rebuilt when the fragments of the page are changed
+    QSharedPointer<QRail::Fragments::Fragment> fragment(new QRail::Fragments::Fragment(
+        QUrl("http://irail.be/connections/8814001/20180721/IC3309"),
+        QUrl("http://irail.be/stations/NMBS/008814001"),
+        QUrl("http://irail.be/stations/NMBS/008813037"),
+        QDateTime::fromString("2018-07-21T07:29:00.000Z", Qt::ISODate),
+        QDateTime::fromString("2018-07-21T07:31:00.000Z", Qt::ISODate),
+        0,
+        60,
+        QUrl("http://irail.be/vehicle/IC3309/20180721"),
+        QUrl("http://irail.be/vehicle/IC3309"),
+        QString("Anvers-Central"),
+        QRail::Fragments::Fragment::GTFSTypes::REGULAR,
+        QRail::Fragments::Fragment::GTFSTypes::NOTAVAILABLE));
+    QCOMPARE(page->connectionTable()->size(), 0);
+    QSignalSpy spyFragmentsChanged(page, SIGNAL(fragmentsChanged()));
+    page->setFragments(QList<QSharedPointer<QRail::Fragments::Fragment>>() << fragment);
+    QCOMPARE(spyFragmentsChanged.count(), 1);
+
+    QSharedPointer<QRail::Fragments::ConnectionTable> table = page->connectionTable();
+    QCOMPARE(table->size(), 1);
+    QCOMPARE(table->departureStationIDs().at(0), fragment->departureStationID());
+    QCOMPARE(table->arrivalStationIDs().at(0), fragment->arrivalStationID());
+    QCOMPARE(table->tripIDs().at(0), fragment->tripID());
+    QCOMPARE(table->departureTimes().at(0), fragment->departureTime().toMSecsSinceEpoch() / 1000);
+    QCOMPARE(table->arrivalTimes().at(0) - table->departureTimes().at(0), (qint64) 120);
+    QCOMPARE(table->pickupTypes().at(0), static_cast<quint8>(QRail::Fragments::Fragment::GTFSTypes::REGULAR));
+    QCOMPARE(table->dropOffTypes().at(0), static_cast<quint8>(QRail::Fragments::Fragment::GTFSTypes::NOTAVAILABLE));
+    QCOMPARE(table->fragment(0), fragment);
 }
 
 void QRail::Fragments::PageTest::cleanLinkedConnectionPageTest()
@@ -0,0 +1,85 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragmentspagewritertest.h"
+using namespace QRail;
+
+void QRail::Fragments::PageWriterTest::initPageWriterTest()
+{
+    qDebug() << "Init QRail::Fragments::PageWriter test";
+    dir = new QTemporaryDir();
+    QVERIFY(dir->isValid());
+}
+
+void QRail::Fragments::PageWriterTest::runCoalescingTest()
+{
+    qDebug() << "Running QRail::Fragments::PageWriter coalescing test";
+    QRail::Fragments::PageStore store(dir->filePath("coalescing.segment"));
+    QRail::Fragments::PageWriter writer(&store);
+    QSharedPointer<QRail::Fragments::Page> first = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 1);
+    QSharedPointer<QRail::Fragments::Page> updated = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 2);
+    QSharedPointer<QRail::Fragments::Page> second = QRail::Fragments::TestPages::page("2018-07-21T07:39:00.000Z", 1);
+
+    // A page queued again before the flush replaces the queued version
+    writer.enqueue(first);
+    writer.enqueue(second);
+    writer.enqueue(updated);
+    QCOMPARE(writer.pendingCount(), 2);
+    QVERIFY(!store.contains(first->uri()));
+
+    // Queued pages are read through until they're written
+    QVERIFY(writer.pendingPage(first->uri()));
+    QCOMPARE(writer.pendingPage(first->uri())->fragments().size(), 2);
+    QCOMPARE(writer.pendingPage(second->uri())->fragments().size(), 1);
+    QVERIFY(!writer.pendingPage(QUrl("https://graph.irail.be/sncb/connections?departureTime=2018-07-21T06:00:00.000Z")));
+
+    // Every page is written once, with its most recent version
+    writer.flush();
+    QCOMPARE(writer.pendingCount(), 0);
+    QVERIFY(!writer.pendingPage(first->uri()));
+    QCOMPARE(store.entries().size(), 2);
+    QCOMPARE(store.read(first->uri())->fragments().size(), 2);
+    QCOMPARE(store.read(second->uri())->fragments().size(), 1);
+
+    QRail::Fragments::PageStore reference(dir->filePath("reference.segment"));
+    QVERIFY(reference.write(updated));
+    QVERIFY(reference.write(second));
+    QCOMPARE(QFileInfo(dir->filePath("coalescing.segment")).size(), QFileInfo(dir->filePath("reference.segment")).size());
+
+    // Nothing left to write
+    writer.flush();
+    QCOMPARE(store.entries().size(), 2);
+}
+
+void QRail::Fragments::PageWriterTest::runScheduledFlushTest()
+{
+    qDebug() << "Running QRail::Fragments::PageWriter scheduled flush test";
+    QRail::Fragments::PageStore store(dir->filePath("scheduled.segment"));
+    QRail::Fragments::PageWriter writer(&store);
+    QSharedPointer<QRail::Fragments::Page> page = QRail::Fragments::TestPages::page("2018-07-21T07:29:00.000Z", 1);
+
+    // The first dirty page starts the flush interval
+    writer.enqueue(page);
+    QCOMPARE(writer.pendingCount(), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(writer.pendingCount(), 0, 2 * PAGE_WRITER_FLUSH_INTERVAL);
+    QVERIFY(store.contains(page->uri()));
+}
+
+void QRail::Fragments::PageWriterTest::cleanPageWriterTest()
+{
+    qDebug() << "Cleaning up QRail::Fragments::PageWriter test";
+    delete dir;
+}
@@ -0,0 +1,48 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSPAGEWRITERTEST_H
+#define FRAGMENTSPAGEWRITERTEST_H
+
+#include "fragments/fragmentspagewriter.h"
+#include "fragments/fragmentspagestore.h"
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentsfragment.h"
+#include "fragmentstestpages.h"
+#include <QtCore/QObject>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QSharedPointer>
+#include <QtTest/QtTest>
+
+namespace QRail {
+namespace Fragments {
+class PageWriterTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initPageWriterTest();
+    void runCoalescingTest();
+    void runScheduledFlushTest();
+    void cleanPageWriterTest();
+
+private:
+    QTemporaryDir *dir;
+};
+} // namespace Fragments
+} // namespace QRail
+
+#endif // FRAGMENTSPAGEWRITERTEST_H
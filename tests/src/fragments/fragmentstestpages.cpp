@@ -0,0 +1,46 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fragmentstestpages.h"
+using namespace QRail;
+
+QSharedPointer<QRail::Fragments::Page> QRail::Fragments::TestPages::page(const QString &departureTime, const qint32 fragmentCount)
+{
+    QDateTime timestamp = QDateTime::fromString(departureTime, Qt::ISODate);
+    QList<QSharedPointer<QRail::Fragments::Fragment> > fragments;
+    for (qint32 i = 0; i < fragmentCount; i++) {
+        QString trip = QString("IC%1%2").arg(timestamp.toString("hhmm")).arg(i);
+        fragments.append(QSharedPointer<QRail::Fragments::Fragment>(new QRail::Fragments::Fragment(
+            QUrl("http://irail.be/connections/8814001/20180721/" + trip),
+            QUrl("http://irail.be/stations/NMBS/008814001"),
+            QUrl("http://irail.be/stations/NMBS/008813037"),
+            timestamp.addSecs(60 * (i + 1)),
+            timestamp.addSecs(60 * (i + 1) + 120),
+            i % 2 == 0? 0: -30,
+            i % 2 == 0? 60: 0,
+            QUrl("http://irail.be/vehicle/" + trip + "/20180721"),
+            QUrl("http://irail.be/vehicle/" + trip),
+            QString("Anvers-Central"),
+            QRail::Fragments::Fragment::GTFSTypes::REGULAR,
+            i % 2 == 0? QRail::Fragments::Fragment::GTFSTypes::NOTAVAILABLE: QRail::Fragments::Fragment::GTFSTypes::REGULAR)));
+    }
+    return QSharedPointer<QRail::Fragments::Page>(new QRail::Fragments::Page(
+        QUrl("https://graph.irail.be/sncb/connections?departureTime=" + departureTime),
+        timestamp,
+        QUrl("https://graph.irail.be/sncb/connections?departureTime=" + timestamp.addSecs(600).toString(Qt::ISODate)),
+        QUrl("https://graph.irail.be/sncb/connections?departureTime=" + timestamp.addSecs(-600).toString(Qt::ISODate)),
+        fragments));
+}
@@ -0,0 +1,45 @@
+/*
+ *   This file is part of QRail.
+ *
+ *   QRail is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   QRail is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with QRail.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAGMENTSTESTPAGES_H
+#define FRAGMENTSTESTPAGES_H
+
+#include "fragments/fragmentspage.h"
+#include "fragments/fragmentsfragment.h"
+#include <QtCore/QDateTime>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <QtCore/QSharedPointer>
+
+namespace QRail {
+namespace Fragments {
+//! Linked Connections pages used by the page cache, store and writer tests.
+class TestPages
+{
+public:
+    //! Creates a page with the given amount of connections, one connection departs every minute after the page timestamp.
+    /*!
+        \param departureTime The ISO timestamp of the page.
+        \param fragmentCount The amount of connections in the page.
+        \note Pages with the same amount of connections have the same size.
+               Delays and GTFS types alternate between the connections.
+     */
+    static QSharedPointer<QRail::Fragments::Page> page(const QString &departureTime, const qint32 fragmentCount = 1);
+};
+} // namespace Fragments
+} // namespace QRail
+
+#endif // FRAGMENTSTESTPAGES_H
@@ -20,10 +20,18 @@
 #include "database/databasemanagertest.h"
 #include "engines/liveboard/liveboardfactorytest.h"
 #include "engines/router/routerplannertest.h"
+#include "engines/router/routerplannerpooltest.h"
+#include "engines/router/routerjourneytest.h"
+#include "engines/router/routerquerytest.h"
+#include "engines/router/routerjourneycachetest.h"
+#include "engines/router/routerdestinationcachetest.h"
 #include "engines/vehicle/vehiclefactorytest.h"
 #include "engines/station/stationfactorytest.h"
 #include "fragments/fragmentsfragmenttest.h"
 #include "fragments/fragmentspagetest.h"
+#include "fragments/fragmentspagestoretest.h"
+#include "fragments/fragmentspagewritertest.h"
+#include "fragments/fragmentscachetest.h"
 #include "network/networkmanagertest.h"
 #include "network/networkeventsourcetest.h"
 #include "qrail.h"
@@ -51,7 +59,15 @@ int main(int argc, char *argv[])
         int dbManagerResult = -1;
         int lcFragmentResult = -1;
         int lcPageResult = -1;
+        int lcPageStoreResult = -1;
+        int lcPageWriterResult = -1;
+        int lcCacheResult = -1;
+        int routerJourneyResult = -1;
+        int routerQueryResult = -1;
+        int routerJourneyCacheResult = -1;
+        int routerDestinationCacheResult = -1;
         int routerPlannerResult = 0; //-1 Needs reproducing tests (test datasets)
+        int routerPlannerPoolResult = -1;
         int liveboardFactoryResult = 0; //-1 Needs reproducing tests (test datasets)
         int vehicleFactoryResult = -1;
         int stationFactoryResult = -1;
@@ -60,7 +76,15 @@ int main(int argc, char *argv[])
         QRail::Database::ManagerTest testSuiteDBManager;
         QRail::Fragments::FragmentTest testSuiteLCFragment;
         QRail::Fragments::PageTest testSuiteLCPage;
+        QRail::Fragments::PageStoreTest testSuiteLCPageStore;
+        QRail::Fragments::PageWriterTest testSuiteLCPageWriter;
+        QRail::Fragments::CacheTest testSuiteLCCache;
         QRail::RouterEngine::PlannerTest testSuiteCSAPlanner;
+        QRail::RouterEngine::PlannerPoolTest testSuiteCSAPlannerPool;
+        QRail::RouterEngine::JourneyTest testSuiteRouterJourney;
+        QRail::RouterEngine::QueryTest testSuiteRouterQuery;
+        QRail::RouterEngine::JourneyCacheTest testSuiteRouterJourneyCache;
+        QRail::RouterEngine::DestinationCacheTest testSuiteRouterDestinationCache;
         QRail::LiveboardEngine::FactoryTest testSuiteLiveboardFactory;
         QRail::VehicleEngine::FactoryTest testSuiteVehicleFactory;
         QRail::StationEngine::FactoryTest testSuiteStationFactory;
@@ -71,6 +95,13 @@ int main(int argc, char *argv[])
         dbManagerResult = QTest::qExec(&testSuiteDBManager, 0, nullptr);
         lcFragmentResult = QTest::qExec(&testSuiteLCFragment, 0, nullptr);
         lcPageResult = QTest::qExec(&testSuiteLCPage, 0, nullptr);
+        lcPageStoreResult = QTest::qExec(&testSuiteLCPageStore, 0, nullptr);
+        lcPageWriterResult = QTest::qExec(&testSuiteLCPageWriter, 0, nullptr);
+        lcCacheResult = QTest::qExec(&testSuiteLCCache, 0, nullptr);
+        routerJourneyResult = QTest::qExec(&testSuiteRouterJourney, 0, nullptr);
+        routerQueryResult = QTest::qExec(&testSuiteRouterQuery, 0, nullptr);
+        routerJourneyCacheResult = QTest::qExec(&testSuiteRouterJourneyCache, 0, nullptr);
+        routerDestinationCacheResult = QTest::qExec(&testSuiteRouterDestinationCache, 0, nullptr);
 
         // Run QRail::StationEngine::Factory integration test
         stationFactoryResult = QTest::qExec(&testSuiteStationFactory, 0, nullptr);
@@ -84,9 +115,12 @@ int main(int argc, char *argv[])
         // Run QRail::RouterEngine::Planner integration test
         routerPlannerResult = QTest::qExec(&testSuiteCSAPlanner, 0, nullptr);
 
+        // Run QRail::RouterEngine::PlannerPool integration test
+        routerPlannerPoolResult = QTest::qExec(&testSuiteCSAPlannerPool, 0, nullptr);
+
         // Return the status code of every test for CI/CD
-        QCoreApplication::exit(networkManagerResult | networkEventSourceResult | dbManagerResult | lcFragmentResult | lcPageResult |
-                               routerPlannerResult | liveboardFactoryResult | vehicleFactoryResult | stationFactoryResult);
+        QCoreApplication::exit(networkManagerResult | networkEventSourceResult | dbManagerResult | lcFragmentResult | lcPageResult | lcPageStoreResult | lcPageWriterResult | lcCacheResult | routerJourneyResult | routerQueryResult | routerJourneyCacheResult | routerDestinationCacheResult |
+                               routerPlannerResult | routerPlannerPoolResult | liveboardFactoryResult | vehicleFactoryResult | stationFactoryResult);
     });
     return app.exec();
 }